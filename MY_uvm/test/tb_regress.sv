@@ -0,0 +1,121 @@
+import uvm_pkg::*;
+`include "uvm_macros.svh"
+`include "timescale.sv"
+
+// Regression checks for the library, kept apart from the tb_top example.
+// Each check reports a UVM_ERROR when it fails.
+
+class pool_item extends uvm_sequence_item;
+  rand bit [31:0] data;
+  rand bit [7:0]  len;
+
+  `uvm_object_utils_begin(pool_item)
+    `uvm_field_int(data, UVM_ALL_ON)
+    `uvm_field_int(len,  UVM_ALL_ON)
+  `uvm_object_utils_end
+
+  function new(string name="pool_item");
+    super.new(name);
+  endfunction
+endclass
+
+module tb_regress;
+
+  // A recycled item must match a new one: same fields, no sequence
+  // context, and the same draw on the acquiring process's RNG.
+  task automatic test_object_pool();
+    uvm_object_pool#(pool_item) pool = new("pool");
+    uvm_sequence_base seq = new("seq");
+    process p = process::self();
+    pool_item fresh, used;
+    string randstate;
+    int unsigned fresh_next, used_next;
+
+    used = pool.acquire("item");
+    void'(used.randomize());
+    used.set_item_context(seq);
+    used.set_sequence_id(7);
+    used.set_transaction_id(3);
+    void'(pool.recycle(used));
+
+    randstate = p.get_randstate();
+    fresh = pool_item::type_id::create("item");
+    fresh_next = $urandom;
+    p.set_randstate(randstate);
+    used = pool.acquire("item");
+    used_next = $urandom;
+
+    if (pool.get_hits() != 1)
+      `uvm_error("POOL", "Second acquire was not served from the pool")
+    if (!used.compare(fresh))
+      `uvm_error("POOL", "Recycled item fields differ from a new item")
+    if (used.get_parent_sequence() != null || used.get_sequencer() != null ||
+        used.get_sequence_id() != fresh.get_sequence_id() ||
+        used.get_use_sequence_info() != fresh.get_use_sequence_info() ||
+        used.get_depth() != fresh.get_depth() ||
+        used.get_transaction_id() != fresh.get_transaction_id())
+      `uvm_error("POOL", "Recycled item kept its sequence context")
+    if (used_next != fresh_next)
+      `uvm_error("POOL", "Recycling changed the process random sequence")
+    `uvm_info("POOL", "Object pool recycling test done", UVM_LOW)
+  endtask
+
+  // Reads each case twice, so that the second read of a cached run is
+  // served from the get cache, and records what was seen.
+  function automatic void config_db_gets(string prefix, ref string results[$]);
+    string insts[] = '{"top.env", "top.env.agent", "top.x", "other", "top.env"};
+    string fields[] = '{"a", "a", "b", "b", "none"};
+    foreach (insts[i])
+      repeat (2) begin
+        int value = -1;
+        bit ok;
+        ok = uvm_config_db#(int)::get(null, insts[i], {prefix, fields[i]}, value);
+        results.push_back($sformatf("%s.%s: %0b %0d", insts[i], fields[i], ok, value));
+      end
+  endfunction
+
+  // Runs the set, set_priority, set_scope, set_precedence and wildcard get
+  // cases on field names starting with ~prefix~.
+  function automatic void config_db_cases(string prefix, ref string results[$]);
+    uvm_resource#(int) r;
+    uvm_config_db#(int)::set(null, "top.*",   {prefix, "a"}, 1);
+    uvm_config_db#(int)::set(null, "top.env", {prefix, "a"}, 2);
+    uvm_config_db#(int)::set(null, "*",       {prefix, "b"}, 10);
+    uvm_config_db#(int)::set(null, "top.*",   {prefix, "b"}, 20);
+    config_db_gets(prefix, results);
+    r = uvm_resource_db#(int)::get_by_name("other", {prefix, "b"});
+    r.set_priority(uvm_resource_types::PRI_HIGH);
+    config_db_gets(prefix, results);
+    uvm_config_db#(int)::set(null, "top.env.*", {prefix, "a"}, 3);
+    config_db_gets(prefix, results);
+    r.set_scope("nowhere.*");
+    config_db_gets(prefix, results);
+    r = uvm_resource_db#(int)::get_by_name("top.x", {prefix, "a"});
+    r.set_precedence(uvm_resource_base::default_precedence + 1);
+    config_db_gets(prefix, results);
+  endfunction
+
+  // Cached and uncached config_db lookups must resolve identically.
+  task automatic test_config_db_cache();
+    string cached[$], uncached[$];
+    uvm_config_db_options::turn_on_caching();
+    config_db_cases("cached_", cached);
+    uvm_config_db_options::turn_off_caching();
+    config_db_cases("uncached_", uncached);
+    uvm_config_db_options::turn_on_caching();
+    if (cached.size() != uncached.size())
+      `uvm_error("CFGDB", "Cached and uncached runs made a different number of gets")
+    foreach (cached[i])
+      if (i < uncached.size() && cached[i] != uncached[i])
+        `uvm_error("CFGDB", $sformatf("Cached get '%s' differs from uncached get '%s'",
+                                      cached[i], uncached[i]))
+    `uvm_info("CFGDB", "Config db cache test done", UVM_LOW)
+  endtask
+
+  initial
+    begin : regress
+      test_object_pool();
+      test_config_db_cache();
+    end : regress
+
+endmodule: tb_regress
@@ -0,0 +1,628 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+//
+// uvm_bin_tr_dump - converts a database written by uvm_bin_tr_database
+// into the format written by uvm_text_tr_database.
+//
+//   cc -O2 -I $UVM_HOME/src/dpi -o uvm_bin_tr_dump $UVM_HOME/bin/uvm_bin_tr_dump.c
+//   uvm_bin_tr_dump [file ...] > tr_db.log
+//
+// Files are read in turn, "-" or no file reads the standard input.
+// Times are printed as %0t prints them under the default $timeformat.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "uvm_bin_tr.h"
+
+// Values of uvm_radix_enum
+#define UVM_BIN       0x1000000
+#define UVM_DEC       0x2000000
+#define UVM_UNSIGNED  0x3000000
+#define UVM_UNFORMAT2 0x4000000
+#define UVM_UNFORMAT4 0x5000000
+#define UVM_OCT       0x6000000
+#define UVM_HEX       0x7000000
+#define UVM_STRING    0x8000000
+#define UVM_TIME      0x9000000
+#define UVM_ENUM      0xa000000
+#define UVM_REAL      0xb000000
+#define UVM_REAL_DEC  0xc000000
+#define UVM_REAL_EXP  0xd000000
+#define UVM_NORADIX   0
+
+static const char *file_name;
+static FILE *in;
+
+// Interned strings of the current session, indexed by id
+static char **strs = NULL;
+static unsigned n_strs = 0;
+
+static double time_scale = 1.0;
+static unsigned streambits = 4096;
+
+// Formatted value
+static char *out = NULL;
+static size_t out_len = 0, out_max = 0;
+
+
+//--------------------------------------------------------------------
+// fail
+//--------------------------------------------------------------------
+static void fail(const char *msg)
+{
+  fprintf(stderr, "uvm_bin_tr_dump: %s: %s\n", file_name, msg);
+  exit(1);
+}
+
+
+//--------------------------------------------------------------------
+// xrealloc
+//--------------------------------------------------------------------
+static void *xrealloc(void *p, size_t n)
+{
+  p = realloc(p, n ? n : 1);
+  if(p == NULL) {
+    fprintf(stderr, "uvm_bin_tr_dump: out of memory\n");
+    exit(1);
+  }
+  return p;
+}
+
+
+//--------------------------------------------------------------------
+// Readers; a record cut short is an error
+//--------------------------------------------------------------------
+static void get(void *p, size_t n)
+{
+  if(n && fread(p, 1, n, in) != n)
+    fail("truncated record");
+}
+
+static unsigned get_u8(void)
+{
+  unsigned char b;
+  get(&b, 1);
+  return b;
+}
+
+static unsigned get_u32(void)
+{
+  unsigned char b[4];
+  get(b, 4);
+  return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned) b[3] << 24);
+}
+
+static int get_i32(void)
+{
+  return (int) get_u32();
+}
+
+static double get_f64(void)
+{
+  unsigned char b[8];
+  unsigned long long u = 0;
+  double v;
+  int i;
+  get(b, 8);
+  for(i = 7; i >= 0; i--)
+    u = (u << 8) | b[i];
+  memcpy(&v, &u, 8);
+  return v;
+}
+
+static const char *get_str(void)
+{
+  unsigned id = get_u32();
+  if(id == 0)
+    return "";
+  if(id > n_strs || strs[id-1] == NULL)
+    fail("reference to an undefined string");
+  return strs[id-1];
+}
+
+
+//--------------------------------------------------------------------
+// Output buffer for values
+//--------------------------------------------------------------------
+static void out_reset(void)
+{
+  if(out == NULL) {
+    out_max = 256;
+    out = (char*) xrealloc(NULL, out_max);
+  }
+  out_len = 0;
+  out[0] = 0;
+}
+
+static void out_char(char c)
+{
+  if(out_len+2 > out_max) {
+    out_max = out_max ? 2*out_max : 256;
+    out = (char*) xrealloc(out, out_max);
+  }
+  out[out_len++] = c;
+  out[out_len] = 0;
+}
+
+static void out_str(const char *s)
+{
+  while(*s)
+    out_char(*s++);
+}
+
+static void out_reverse(size_t from)
+{
+  size_t i = from, j = out_len-1;
+  while(i < j) {
+    char c = out[i];
+    out[i++] = out[j];
+    out[j--] = c;
+  }
+}
+
+
+//--------------------------------------------------------------------
+// fmt_time
+//
+// %0t of a time or realtime, scaled to the simulation precision.
+//--------------------------------------------------------------------
+static const char *fmt_time(double t)
+{
+  static char buf[64];
+  snprintf(buf, sizeof(buf), "%.0f", t * time_scale);
+  return buf;
+}
+
+
+//--------------------------------------------------------------------
+// Values
+//
+// ~aval~ and ~bval~ hold the value zero extended to ~width~ bits, the
+// width of the uvm_bitstream_t or uvm_integral_t it was recorded from.
+//--------------------------------------------------------------------
+static unsigned *aval = NULL, *bval = NULL;
+static unsigned max_words = 0;
+static unsigned width;
+
+static int bit_a(unsigned i) { return (aval[i >> 5] >> (i & 31)) & 1; }
+static int bit_b(unsigned i) { return (bval[i >> 5] >> (i & 31)) & 1; }
+
+static int is_unknown(unsigned words)
+{
+  unsigned i;
+  for(i = 0; i < words; i++)
+    if(bval[i])
+      return 1;
+  return 0;
+}
+
+
+//--------------------------------------------------------------------
+// fmt_unknown
+//
+// %d of a value with x or z bits.
+//--------------------------------------------------------------------
+static void fmt_unknown(unsigned numbits)
+{
+  unsigned i, x = 0, z = 0;
+  for(i = 0; i < numbits; i++)
+    if(bit_b(i)) {
+      if(bit_a(i)) x++;
+      else z++;
+    }
+  if(x == width)
+    out_char('x');
+  else if(z == width)
+    out_char('z');
+  else
+    out_char(x ? 'X' : 'Z');
+}
+
+
+//--------------------------------------------------------------------
+// fmt_radix
+//
+// %0b, %0o or %0x; ~k~ is the number of bits per digit.
+//--------------------------------------------------------------------
+static void fmt_radix(unsigned numbits, unsigned k)
+{
+  static const char digits[] = "0123456789abcdef";
+  unsigned ndig = (numbits + k-1) / k;
+  size_t from = out_len;
+  unsigned d;
+
+  for(d = 0; d < ndig; d++) {
+    unsigned lo = d*k, hi = d*k + k, i, v = 0, x = 0, z = 0;
+    if(hi > width)
+      hi = width;
+    for(i = lo; i < hi; i++) {
+      if(i >= numbits)
+        continue;
+      if(bit_b(i)) {
+        if(bit_a(i)) x++;
+        else z++;
+      }
+      else
+        v |= bit_a(i) << (i-lo);
+    }
+    if(x == hi-lo)
+      out_char('x');
+    else if(z == hi-lo)
+      out_char('z');
+    else if(x)
+      out_char('X');
+    else if(z)
+      out_char('Z');
+    else
+      out_char(digits[v]);
+  }
+  while(out_len > from+1 && out[out_len-1] == '0')
+    out[--out_len] = 0;
+  if(out_len == from)
+    out_char('0');
+  out_reverse(from);
+}
+
+
+//--------------------------------------------------------------------
+// fmt_dec
+//
+// %d of a known value; ~scale~ multiplies it by a power of ten first,
+// for %0t.
+//--------------------------------------------------------------------
+static void fmt_dec(unsigned words, unsigned scale)
+{
+  unsigned n = words + (scale+8)/9 + 1, i;
+  size_t from = out_len;
+  unsigned *v = (unsigned*) xrealloc(NULL, n * sizeof(unsigned));
+
+  memset(v, 0, n * sizeof(unsigned));
+  memcpy(v, aval, words * sizeof(unsigned));
+
+  while(scale) {
+    unsigned m = 1, s = scale > 9 ? 9 : scale;
+    unsigned long long c = 0;
+    scale -= s;
+    while(s--)
+      m *= 10;
+    for(i = 0; i < n; i++) {
+      c += (unsigned long long) v[i] * m;
+      v[i] = (unsigned) c;
+      c >>= 32;
+    }
+  }
+
+  while(n && v[n-1] == 0)
+    n--;
+  do {
+    unsigned long long r = 0;
+    int j;
+    for(j = (int) n-1; j >= 0; j--) {
+      r = (r << 32) | v[j];
+      v[j] = (unsigned) (r / 1000000000u);
+      r %= 1000000000u;
+    }
+    while(n && v[n-1] == 0)
+      n--;
+    for(j = 0; j < 9 && (n || r); j++) {
+      out_char((char) ('0' + r % 10));
+      r /= 10;
+    }
+  } while(n);
+  if(out_len == from)
+    out_char('0');
+  out_reverse(from);
+  free(v);
+}
+
+
+//--------------------------------------------------------------------
+// fmt_string
+//
+// %0s; leading NUL characters are not printed.
+//--------------------------------------------------------------------
+static void fmt_string(unsigned numbits)
+{
+  int j, started = 0;
+  for(j = (int) (numbits+7)/8 - 1; j >= 0; j--) {
+    char c = (char) (aval[j >> 2] >> (8*(j & 3)));
+    if(c == 0 && !started)
+      continue;
+    started = 1;
+    out_char(c);
+  }
+}
+
+
+//--------------------------------------------------------------------
+// fmt_value
+//
+// Formats the value as uvm_bitstream_to_string does.
+//--------------------------------------------------------------------
+static void fmt_value(unsigned words, unsigned numbits, unsigned radix)
+{
+  out_reset();
+  switch(radix) {
+  case UVM_BIN:
+    fmt_radix(numbits, 1);
+    break;
+  case UVM_OCT:
+    fmt_radix(numbits, 3);
+    break;
+  case UVM_DEC:
+  case UVM_UNSIGNED:
+    if(is_unknown(words))
+      fmt_unknown(numbits);
+    else
+      fmt_dec(words, 0);
+    break;
+  case UVM_STRING:
+    fmt_string(numbits);
+    break;
+  case UVM_TIME:
+    if(is_unknown(words))
+      fmt_unknown(numbits);
+    else {
+      unsigned scale = 0;
+      double ts = time_scale;
+      while(ts >= 10.0) {
+        ts /= 10.0;
+        scale++;
+      }
+      if(ts == 1.0)
+        fmt_dec(words, scale);
+      else {
+        // not a power of ten; good enough for %0t
+        double t = 0;
+        int i;
+        for(i = (int) words-1; i >= 0; i--)
+          t = t * 4294967296.0 + aval[i];
+        out_str(fmt_time(t));
+      }
+    }
+    break;
+  default:
+    fmt_radix(numbits, 4);
+    break;
+  }
+}
+
+
+//--------------------------------------------------------------------
+// radix_name
+//--------------------------------------------------------------------
+static const char *radix_name(unsigned radix)
+{
+  switch(radix) {
+  case UVM_BIN:       return "UVM_BIN";
+  case UVM_DEC:       return "UVM_DEC";
+  case UVM_UNSIGNED:  return "UVM_UNSIGNED";
+  case UVM_UNFORMAT2: return "UVM_UNFORMAT2";
+  case UVM_UNFORMAT4: return "UVM_UNFORMAT4";
+  case UVM_OCT:       return "UVM_OCT";
+  case UVM_HEX:       return "UVM_HEX";
+  case UVM_STRING:    return "UVM_STRING";
+  case UVM_TIME:      return "UVM_TIME";
+  case UVM_ENUM:      return "UVM_ENUM";
+  case UVM_REAL:      return "UVM_REAL";
+  case UVM_REAL_DEC:  return "UVM_REAL_DEC";
+  case UVM_REAL_EXP:  return "UVM_REAL_EXP";
+  case UVM_NORADIX:   return "UVM_NORADIX";
+  }
+  return "";
+}
+
+
+//--------------------------------------------------------------------
+// start_session
+//
+// Called with the first byte of the magic string already read.
+//--------------------------------------------------------------------
+static void start_session(void)
+{
+  char magic[UVM_BIN_TR_MAGIC_LEN];
+  unsigned i;
+
+  magic[0] = UVM_BIN_TR_MAGIC[0];
+  get(magic+1, UVM_BIN_TR_MAGIC_LEN-1);
+  if(memcmp(magic, UVM_BIN_TR_MAGIC, UVM_BIN_TR_MAGIC_LEN) != 0)
+    fail("not a transaction database");
+  time_scale = get_f64();
+  streambits = get_u32();
+  for(i = 0; i < n_strs; i++)
+    free(strs[i]);
+  n_strs = 0;
+}
+
+
+//--------------------------------------------------------------------
+// dump_attr
+//--------------------------------------------------------------------
+static void dump_attr(double t)
+{
+  int txh = get_i32();
+  const char *name = get_str();
+  unsigned radix = get_u32();
+  unsigned numbits = get_u32();
+  unsigned flags = get_u8();
+  unsigned words = (numbits+31) / 32, i;
+
+  width = (flags & UVM_BIN_TR_INTEGRAL) ? 64 : streambits;
+  if(numbits > width)
+    fail("attribute wider than its value");
+  if((width+31)/32 > max_words) {
+    max_words = (width+31)/32;
+    aval = (unsigned*) xrealloc(aval, max_words * sizeof(unsigned));
+    bval = (unsigned*) xrealloc(bval, max_words * sizeof(unsigned));
+  }
+  memset(aval, 0, max_words * sizeof(unsigned));
+  memset(bval, 0, max_words * sizeof(unsigned));
+  for(i = 0; i < words; i++)
+    aval[i] = get_u32();
+  if(flags & UVM_BIN_TR_4STATE)
+    for(i = 0; i < words; i++)
+      bval[i] = get_u32();
+
+  fmt_value(words, numbits, radix);
+  printf("      SET_ATTR @%s {TXH:%d NAME:%s VALUE:%s   RADIX:%s BITS=%d}\n",
+         fmt_time(t), txh, name, out, radix_name(radix), (int) numbits);
+}
+
+
+//--------------------------------------------------------------------
+// dump_attr_string
+//--------------------------------------------------------------------
+static void dump_attr_string(double t)
+{
+  int txh = get_i32();
+  const char *name = get_str();
+  unsigned radix = get_u32();
+  unsigned numbits = get_u32();
+  unsigned len = get_u32();
+
+  out_reset();
+  while(len--)
+    out_char((char) get_u8());
+  printf("      SET_ATTR @%s {TXH:%d NAME:%s VALUE:%s   RADIX:%s BITS=%d}\n",
+         fmt_time(t), txh, name, out, radix_name(radix), (int) numbits);
+}
+
+
+//--------------------------------------------------------------------
+// dump
+//--------------------------------------------------------------------
+static void dump(void)
+{
+  int tag;
+  int started = 0;
+
+  while((tag = getc(in)) != EOF) {
+    double t;
+
+    if(tag == UVM_BIN_TR_MAGIC[0]) {
+      start_session();
+      started = 1;
+      continue;
+    }
+    if(!started)
+      fail("not a transaction database");
+
+    if(tag == UVM_BIN_TR_STRING) {
+      unsigned id = get_u32();
+      unsigned len = get_u32();
+      char *s = (char*) xrealloc(NULL, len+1);
+      get(s, len);
+      s[len] = 0;
+      if(id != n_strs+1)
+        fail("string ids out of sequence");
+      strs = (char**) xrealloc(strs, id * sizeof(char*));
+      strs[n_strs++] = s;
+      continue;
+    }
+
+    t = get_f64();
+    switch(tag) {
+    case UVM_BIN_TR_CREATE_STREAM:
+    case UVM_BIN_TR_CLOSE_STREAM:
+    case UVM_BIN_TR_FREE_STREAM: {
+      const char *kind = tag == UVM_BIN_TR_CREATE_STREAM ? "CREATE" :
+                         tag == UVM_BIN_TR_CLOSE_STREAM  ? "CLOSE" : "FREE";
+      int stream = get_i32();
+      const char *name = get_str();
+      const char *type_name = get_str();
+      const char *scope = get_str();
+      printf("  %s_STREAM @%s {NAME:%s T:%s SCOPE:%s STREAM:%d}\n",
+             kind, fmt_time(t), name, type_name, scope, stream);
+      break;
+    }
+    case UVM_BIN_TR_OPEN_RECORDER: {
+      int txh = get_i32();
+      int stream = get_i32();
+      const char *name = get_str();
+      double open_time = get_f64();
+      const char *type_name = get_str();
+      printf("    OPEN_RECORDER @%s", fmt_time(t));
+      printf(" {TXH:%d STREAM:%d NAME:%s TIME:%s TYPE=\"%s\"}\n",
+             txh, stream, name, fmt_time(open_time), type_name);
+      break;
+    }
+    case UVM_BIN_TR_CLOSE_RECORDER: {
+      int txh = get_i32();
+      double close_time = get_f64();
+      printf("    CLOSE_RECORDER @%s", fmt_time(t));
+      printf(" {TXH:%d TIME=%s}\n", txh, fmt_time(close_time));
+      break;
+    }
+    case UVM_BIN_TR_FREE_RECORDER: {
+      int txh = get_i32();
+      printf("    FREE_RECORDER @%s {TXH:%d}\n", fmt_time(t), txh);
+      break;
+    }
+    case UVM_BIN_TR_ATTR:
+      dump_attr(t);
+      break;
+    case UVM_BIN_TR_ATTR_STRING:
+      dump_attr_string(t);
+      break;
+    case UVM_BIN_TR_LINK: {
+      int txh1 = get_i32();
+      int txh2 = get_i32();
+      const char *relation = get_str();
+      printf("  LINK @%s {TXH1:%d TXH2:%d RELATION=%s}\n",
+             fmt_time(t), txh1, txh2, relation);
+      break;
+    }
+    default:
+      fail("unknown record");
+    }
+  }
+}
+
+
+//--------------------------------------------------------------------
+// main
+//--------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  int i;
+
+  if(argc < 2) {
+    file_name = "-";
+    in = stdin;
+    dump();
+    return 0;
+  }
+
+  for(i = 1; i < argc; i++) {
+    file_name = argv[i];
+    if(strcmp(file_name, "-") == 0)
+      in = stdin;
+    else if((in = fopen(file_name, "rb")) == NULL) {
+      fprintf(stderr, "uvm_bin_tr_dump: cannot open %s\n", file_name);
+      return 1;
+    }
+    dump();
+    if(in != stdin)
+      fclose(in);
+  }
+  return 0;
+}
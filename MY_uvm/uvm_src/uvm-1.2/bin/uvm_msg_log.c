@@ -0,0 +1,849 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+//
+// uvm_msg_log - indexes and filters a message log written by
+// uvm_default_report_server::enable_message_log, and prints the
+// selected messages in the format the report server displays them in.
+//
+//   cc -O2 -I $UVM_HOME/src/dpi -o uvm_msg_log $UVM_HOME/bin/uvm_msg_log.c
+//   uvm_msg_log -index uvm_messages.bin
+//   uvm_msg_log -severity UVM_ERROR -id MY_ID -from 1000 -to 2000 uvm_messages.bin
+//
+// Options select the messages to print; all must match.
+//
+//   -severity SEV[,SEV...]  UVM_INFO, UVM_WARNING, UVM_ERROR or UVM_FATAL;
+//                           the UVM_ prefix may be left out
+//   -id ID                  message id; may be given more than once
+//   -name GLOB              full name of the reporter
+//   -message GLOB           message text
+//   -from TIME, -to TIME    first and last time, as printed
+//   -count                  print the number of messages only
+//   -noindex                ignore the index
+//
+// -index writes an index to FILE.idx, which lets later runs skip the
+// parts of FILE that cannot hold a selected message.  Messages appended
+// to FILE after it was indexed are still read, without the help of the
+// index.  Files are read in turn; "-" or no file reads the standard
+// input, which is not indexed.  Times are printed as %0t prints them
+// under the default $timeformat.
+//
+
+#define _FILE_OFFSET_BITS 64
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <setjmp.h>
+#include <fnmatch.h>
+#include "uvm_msg_log.h"
+
+typedef unsigned long long u64;
+
+typedef struct {
+  u64      offset;
+  double   time_scale;
+  char   **strs;        // indexed by id-1
+  unsigned n_strs;
+} session_t;
+
+typedef struct {
+  u64           offset;
+  u64           end;
+  unsigned      session;
+  double        t_min;
+  double        t_max;
+  unsigned      sev_mask;
+  unsigned char bloom[UVM_MSG_LOG_BLOOM_BYTES];
+} block_t;
+
+static const char *sev_names[4] = { "UVM_INFO", "UVM_WARNING", "UVM_ERROR", "UVM_FATAL" };
+
+static const char *file_name;
+static FILE *in;
+static u64 pos;                 // offset of the next byte of ~in~
+static jmp_buf truncated;
+
+// Selection
+static unsigned sel_sev_mask = 0xf;
+static const char **sel_ids = NULL;
+static unsigned n_sel_ids = 0;
+static const char *sel_name = NULL;
+static const char *sel_message = NULL;
+static int sel_from_set = 0, sel_to_set = 0;
+static double sel_from, sel_to;
+static int count_only = 0;
+static u64 count = 0;
+
+// Sessions and blocks of the log being read or indexed
+static session_t *sessions = NULL;
+static unsigned n_sessions = 0;
+static block_t *blocks = NULL;
+static unsigned n_blocks = 0;
+
+// The session being read, and what is known of its strings: 1 if the
+// string is a selected id, and 1 or 2 if it is a name that does or does
+// not match -name, 0 while not yet checked.
+static session_t *cur = NULL;
+static unsigned char *str_is_id = NULL;
+static unsigned char *str_name_match = NULL;
+static unsigned str_info_max = 0;
+
+// Message text
+static char *text = NULL;
+static size_t text_max = 0;
+
+
+//--------------------------------------------------------------------
+// fail
+//--------------------------------------------------------------------
+static void fail(const char *msg)
+{
+  fprintf(stderr, "uvm_msg_log: %s: %s\n", file_name, msg);
+  exit(1);
+}
+
+
+//--------------------------------------------------------------------
+// xrealloc
+//--------------------------------------------------------------------
+static void *xrealloc(void *p, size_t n)
+{
+  p = realloc(p, n ? n : 1);
+  if(p == NULL) {
+    fprintf(stderr, "uvm_msg_log: out of memory\n");
+    exit(1);
+  }
+  return p;
+}
+
+
+//--------------------------------------------------------------------
+// Readers; a record cut short jumps to ~truncated~
+//--------------------------------------------------------------------
+static void get(void *p, size_t n)
+{
+  if(n && fread(p, 1, n, in) != n)
+    longjmp(truncated, 1);
+  pos += n;
+}
+
+static unsigned get_u8(void)
+{
+  unsigned char b;
+  get(&b, 1);
+  return b;
+}
+
+static unsigned get_u32(void)
+{
+  unsigned char b[4];
+  get(b, 4);
+  return b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned) b[3] << 24);
+}
+
+static u64 get_u64(void)
+{
+  u64 lo = get_u32();
+  return lo | ((u64) get_u32() << 32);
+}
+
+static double get_f64(void)
+{
+  u64 u = get_u64();
+  double v;
+  memcpy(&v, &u, 8);
+  return v;
+}
+
+static char *get_bytes(unsigned len)
+{
+  char *s = (char*) xrealloc(NULL, len+1);
+  get(s, len);
+  s[len] = 0;
+  return s;
+}
+
+
+//--------------------------------------------------------------------
+// Writers of the index
+//--------------------------------------------------------------------
+static void put_u32(FILE *fp, unsigned v)
+{
+  unsigned char b[4];
+  b[0] = (unsigned char) v;
+  b[1] = (unsigned char) (v >> 8);
+  b[2] = (unsigned char) (v >> 16);
+  b[3] = (unsigned char) (v >> 24);
+  fwrite(b, 1, 4, fp);
+}
+
+static void put_u64(FILE *fp, u64 v)
+{
+  put_u32(fp, (unsigned) v);
+  put_u32(fp, (unsigned) (v >> 32));
+}
+
+static void put_f64(FILE *fp, double v)
+{
+  u64 u;
+  memcpy(&u, &v, 8);
+  put_u64(fp, u);
+}
+
+
+//--------------------------------------------------------------------
+// str
+//--------------------------------------------------------------------
+static const char *str(unsigned id)
+{
+  if(id == 0)
+    return "";
+  if(id > cur->n_strs)
+    fail("reference to an undefined string");
+  return cur->strs[id-1];
+}
+
+
+//--------------------------------------------------------------------
+// note_string
+//
+// Records what the selection needs to know of string ~id~ of the
+// current session.
+//--------------------------------------------------------------------
+static void note_string(unsigned id)
+{
+  unsigned i;
+
+  if(id >= str_info_max) {
+    unsigned n = str_info_max ? str_info_max : 1024;
+    while(n <= id)
+      n *= 2;
+    str_is_id = (unsigned char*) xrealloc(str_is_id, n);
+    str_name_match = (unsigned char*) xrealloc(str_name_match, n);
+    str_info_max = n;
+  }
+  str_is_id[id] = 0;
+  str_name_match[id] = 0;
+  for(i = 0; i < n_sel_ids; i++)
+    if(strcmp(cur->strs[id-1], sel_ids[i]) == 0)
+      str_is_id[id] = 1;
+}
+
+
+//--------------------------------------------------------------------
+// enter_session
+//
+// Makes ~s~ the session being read.
+//--------------------------------------------------------------------
+static void enter_session(session_t *s)
+{
+  unsigned i;
+  cur = s;
+  for(i = 1; i <= s->n_strs; i++)
+    note_string(i);
+}
+
+
+//--------------------------------------------------------------------
+// new_session
+//
+// Reads a session header, the first byte of which has been read.
+//--------------------------------------------------------------------
+static session_t *new_session(u64 offset)
+{
+  char magic[UVM_MSG_LOG_MAGIC_LEN];
+  session_t *s;
+
+  magic[0] = UVM_MSG_LOG_MAGIC[0];
+  get(magic+1, UVM_MSG_LOG_MAGIC_LEN-1);
+  if(memcmp(magic, UVM_MSG_LOG_MAGIC, UVM_MSG_LOG_MAGIC_LEN) != 0)
+    fail("not a message log");
+
+  sessions = (session_t*) xrealloc(sessions, (n_sessions+1) * sizeof(session_t));
+  s = &sessions[n_sessions++];
+  s->offset = offset;
+  s->time_scale = get_f64();
+  s->strs = NULL;
+  s->n_strs = 0;
+  return s;
+}
+
+
+//--------------------------------------------------------------------
+// add_string
+//--------------------------------------------------------------------
+static void add_string(unsigned id, char *s)
+{
+  if(id != cur->n_strs+1)
+    fail("string ids out of sequence");
+  cur->strs = (char**) xrealloc(cur->strs, id * sizeof(char*));
+  cur->strs[cur->n_strs++] = s;
+  note_string(id);
+}
+
+
+//--------------------------------------------------------------------
+// verbosity_name
+//--------------------------------------------------------------------
+static const char *verbosity_name(int verbosity)
+{
+  static char buf[16];
+  switch(verbosity) {
+  case 0:   return "UVM_NONE";
+  case 100: return "UVM_LOW";
+  case 200: return "UVM_MEDIUM";
+  case 300: return "UVM_HIGH";
+  case 400: return "UVM_FULL";
+  case 500: return "UVM_DEBUG";
+  }
+  snprintf(buf, sizeof(buf), "%d", verbosity);
+  return buf;
+}
+
+
+//--------------------------------------------------------------------
+// read_message
+//
+// Reads a MESSAGE record, the tag of which has been read, and prints
+// it if it is selected.  When indexing, ~b~ is the block it belongs to.
+//--------------------------------------------------------------------
+static void read_message(block_t *b)
+{
+  double t = get_f64();
+  unsigned sev = get_u8() & 3;
+  unsigned flags = get_u8();
+  int verbosity = (int) get_u32();
+  unsigned id = get_u32();
+  unsigned name = get_u32();
+  unsigned context = get_u32();
+  unsigned file = get_u32();
+  int line = (int) get_u32();
+  unsigned len = get_u32();
+  double st = t * cur->time_scale;
+  int selected;
+
+  if(id > cur->n_strs || name > cur->n_strs ||
+     context > cur->n_strs || file > cur->n_strs)
+    fail("reference to an undefined string");
+
+  if(b != NULL) {
+    if(b->sev_mask == 0 || st < b->t_min)
+      b->t_min = st;
+    if(b->sev_mask == 0 || st > b->t_max)
+      b->t_max = st;
+    b->sev_mask |= 1u << sev;
+    b->bloom[UVM_MSG_LOG_BLOOM_1(id) / 8] |= 1 << (UVM_MSG_LOG_BLOOM_1(id) % 8);
+    b->bloom[UVM_MSG_LOG_BLOOM_2(id) / 8] |= 1 << (UVM_MSG_LOG_BLOOM_2(id) % 8);
+  }
+
+  selected = (b == NULL) &&
+             (sel_sev_mask & (1u << sev)) &&
+             (!sel_from_set || st >= sel_from) &&
+             (!sel_to_set || st <= sel_to) &&
+             (n_sel_ids == 0 || (id != 0 && str_is_id[id]));
+  if(selected && sel_name != NULL) {
+    if(name == 0)
+      selected = fnmatch(sel_name, "", 0) == 0;
+    else {
+      if(str_name_match[name] == 0)
+        str_name_match[name] = fnmatch(sel_name, str(name), 0) == 0 ? 1 : 2;
+      selected = str_name_match[name] == 1;
+    }
+  }
+
+  if(!selected && (b != NULL || count_only || sel_message == NULL)) {
+    // skip the text
+    char skip[4096];
+    while(len) {
+      unsigned n = len < sizeof(skip) ? len : sizeof(skip);
+      get(skip, n);
+      len -= n;
+    }
+    return;
+  }
+
+  if(len+1 > text_max) {
+    text_max = len+1;
+    text = (char*) xrealloc(text, text_max);
+  }
+  get(text, len);
+  text[len] = 0;
+
+  if(!selected || (sel_message != NULL && fnmatch(sel_message, text, 0) != 0))
+    return;
+
+  count++;
+  if(count_only)
+    return;
+
+  fputs(sev_names[sev], stdout);
+  if(flags & UVM_MSG_LOG_SHOW_VERBOSITY)
+    printf("(%s)", verbosity_name(verbosity));
+  putchar(' ');
+  if(file != 0)
+    printf("%s(%d) ", str(file), line);
+  printf("@ %.0f: %s", st, str(name));
+  if(context != 0)
+    printf("@@%s", str(context));
+  printf(" [%s] %s", str(id), text);
+  if(flags & UVM_MSG_LOG_SHOW_TERMINATOR)
+    printf(" -%s", sev_names[sev]);
+  putchar('\n');
+}
+
+
+//--------------------------------------------------------------------
+// scan
+//
+// Reads records from the current position up to ~end~, or to the end
+// of the file if ~end~ is 0.  STRING records are added to the current
+// session unless ~known~ is set, when the index already supplied them.
+// When ~indexing~, sessions and blocks are collected instead of
+// printing messages.  Returns the offset after the last whole record.
+//--------------------------------------------------------------------
+static u64 scan(u64 end, int known, int indexing)
+{
+  volatile u64 done = pos;
+  block_t *volatile b = NULL;
+  int tag;
+
+  if(setjmp(truncated)) {
+    fprintf(stderr, "uvm_msg_log: %s: ignoring a record cut short at the end\n", file_name);
+    return done;
+  }
+
+  while((end == 0 || pos < end) && (tag = getc(in)) != EOF) {
+    u64 start = pos++;
+
+    if(tag == UVM_MSG_LOG_MAGIC[0]) {
+      enter_session(new_session(start));
+      b = NULL;
+    }
+    else if(cur == NULL)
+      fail("not a message log");
+    else if(tag == UVM_MSG_LOG_STRING) {
+      unsigned id = get_u32();
+      unsigned len = get_u32();
+      char *s = get_bytes(len);
+      if(known)
+        free(s);
+      else
+        add_string(id, s);
+    }
+    else if(tag == UVM_MSG_LOG_MESSAGE) {
+      if(indexing && (b == NULL || pos - b->offset >= UVM_MSG_LOG_BLOCK_SIZE)) {
+        blocks = (block_t*) xrealloc(blocks, (n_blocks+1) * sizeof(block_t));
+        b = &blocks[n_blocks++];
+        memset(b, 0, sizeof(block_t));
+        b->offset = start;
+        b->session = (unsigned) (cur - sessions);
+      }
+      read_message(b);
+    }
+    else
+      fail("unknown record");
+
+    done = pos;
+    if(b != NULL)
+      b->end = pos;
+  }
+  return done;
+}
+
+
+//--------------------------------------------------------------------
+// open_log
+//--------------------------------------------------------------------
+static void open_log(const char *name)
+{
+  static char buf[1 << 20];
+  file_name = name;
+  if(strcmp(name, "-") == 0)
+    in = stdin;
+  else if((in = fopen(name, "rb")) == NULL) {
+    fprintf(stderr, "uvm_msg_log: cannot open %s\n", name);
+    exit(1);
+  }
+  setvbuf(in, buf, _IOFBF, sizeof(buf));
+  pos = 0;
+  cur = NULL;
+}
+
+
+//--------------------------------------------------------------------
+// free_sessions
+//--------------------------------------------------------------------
+static void free_sessions(void)
+{
+  unsigned i, j;
+  for(i = 0; i < n_sessions; i++) {
+    for(j = 0; j < sessions[i].n_strs; j++)
+      free(sessions[i].strs[j]);
+    free(sessions[i].strs);
+  }
+  free(sessions);
+  free(blocks);
+  sessions = NULL;
+  blocks = NULL;
+  n_sessions = n_blocks = 0;
+  cur = NULL;
+}
+
+
+//--------------------------------------------------------------------
+// close_log
+//--------------------------------------------------------------------
+static void close_log(void)
+{
+  free_sessions();
+  if(in != stdin)
+    fclose(in);
+}
+
+
+//--------------------------------------------------------------------
+// index_log
+//
+// Writes the index of ~name~ to ~name~.idx.
+//--------------------------------------------------------------------
+static void index_log(const char *name)
+{
+  char *idx_name = (char*) xrealloc(NULL, strlen(name) + 8);
+  char *tmp_name = (char*) xrealloc(NULL, strlen(name) + 8);
+  FILE *fp;
+  u64 size;
+  unsigned i, j;
+
+  open_log(name);
+  if(in == stdin)
+    fail("the standard input cannot be indexed");
+  size = scan(0, 0, 1);
+
+  sprintf(idx_name, "%s.idx", name);
+  sprintf(tmp_name, "%s.idx~", name);
+  if((fp = fopen(tmp_name, "wb")) == NULL) {
+    fprintf(stderr, "uvm_msg_log: cannot write %s\n", tmp_name);
+    exit(1);
+  }
+  fwrite(UVM_MSG_LOG_INDEX_MAGIC, 1, UVM_MSG_LOG_INDEX_MAGIC_LEN, fp);
+  put_u64(fp, size);
+  put_u32(fp, n_sessions);
+  for(i = 0; i < n_sessions; i++) {
+    put_u64(fp, sessions[i].offset);
+    put_f64(fp, sessions[i].time_scale);
+    put_u32(fp, sessions[i].n_strs);
+    for(j = 0; j < sessions[i].n_strs; j++) {
+      unsigned len = (unsigned) strlen(sessions[i].strs[j]);
+      put_u32(fp, len);
+      fwrite(sessions[i].strs[j], 1, len, fp);
+    }
+  }
+  put_u32(fp, n_blocks);
+  for(i = 0; i < n_blocks; i++) {
+    put_u64(fp, blocks[i].offset);
+    put_u64(fp, blocks[i].end);
+    put_u32(fp, blocks[i].session);
+    put_f64(fp, blocks[i].t_min);
+    put_f64(fp, blocks[i].t_max);
+    fputc(blocks[i].sev_mask, fp);
+    fwrite(blocks[i].bloom, 1, UVM_MSG_LOG_BLOOM_BYTES, fp);
+  }
+  if(fclose(fp) != 0 || rename(tmp_name, idx_name) != 0) {
+    fprintf(stderr, "uvm_msg_log: cannot write %s\n", idx_name);
+    exit(1);
+  }
+
+  close_log();
+  free(idx_name);
+  free(tmp_name);
+}
+
+
+//--------------------------------------------------------------------
+// read_index
+//
+// Loads the index of the open log into ~sessions~ and ~blocks~, and
+// returns the size of the log it covers, or 0 if there is no usable
+// index.
+//--------------------------------------------------------------------
+static u64 read_index(void)
+{
+  char *idx_name = (char*) xrealloc(NULL, strlen(file_name) + 8);
+  char magic[UVM_MSG_LOG_INDEX_MAGIC_LEN];
+  FILE *log_in = in;
+  u64 log_pos = pos;
+  volatile u64 size = 0;
+  unsigned i, j, n;
+
+  sprintf(idx_name, "%s.idx", file_name);
+  in = fopen(idx_name, "rb");
+  free(idx_name);
+  if(in == NULL) {
+    in = log_in;
+    return 0;
+  }
+
+  if(setjmp(truncated)) {
+    fprintf(stderr, "uvm_msg_log: %s: the index is damaged and is ignored\n", file_name);
+    size = 0;
+  }
+  else if(fread(magic, 1, sizeof(magic), in) != sizeof(magic) ||
+          memcmp(magic, UVM_MSG_LOG_INDEX_MAGIC, sizeof(magic)) != 0)
+    fprintf(stderr, "uvm_msg_log: %s: the index is not a message log index and is ignored\n",
+            file_name);
+  else {
+    size = get_u64();
+    n = get_u32();
+    for(i = 0; i < n; i++) {
+      session_t *s;
+      sessions = (session_t*) xrealloc(sessions, (n_sessions+1) * sizeof(session_t));
+      s = &sessions[n_sessions++];
+      s->offset = get_u64();
+      s->time_scale = get_f64();
+      s->strs = NULL;
+      s->n_strs = 0;
+      for(j = get_u32(); j > 0; j--) {
+        s->strs = (char**) xrealloc(s->strs, (s->n_strs+1) * sizeof(char*));
+        s->strs[s->n_strs] = get_bytes(get_u32());
+        s->n_strs++;
+      }
+    }
+    n = get_u32();
+    for(i = 0; i < n; i++) {
+      blocks = (block_t*) xrealloc(blocks, (n_blocks+1) * sizeof(block_t));
+      n_blocks++;
+      blocks[i].offset = get_u64();
+      blocks[i].end = get_u64();
+      blocks[i].session = get_u32();
+      blocks[i].t_min = get_f64();
+      blocks[i].t_max = get_f64();
+      blocks[i].sev_mask = get_u8();
+      get(blocks[i].bloom, UVM_MSG_LOG_BLOOM_BYTES);
+      if(blocks[i].session >= n_sessions)
+        longjmp(truncated, 1);
+    }
+  }
+  fclose(in);
+  in = log_in;
+  pos = log_pos;
+
+  if(size != 0) {
+    fseeko(in, 0, SEEK_END);
+    if((u64) ftello(in) < size) {
+      fprintf(stderr, "uvm_msg_log: %s: the log is shorter than when it was indexed, "
+              "the index is ignored\n", file_name);
+      size = 0;
+    }
+    fseeko(in, 0, SEEK_SET);
+  }
+  if(size == 0)
+    free_sessions();
+  return size;
+}
+
+
+//--------------------------------------------------------------------
+// block_selected
+//
+// Returns 1 if block ~b~ may hold a selected message.  ~ids~ are the
+// string ids of the selected message ids in the block's session.
+//--------------------------------------------------------------------
+static int block_selected(const block_t *b, const unsigned *ids, unsigned n_ids)
+{
+  unsigned i;
+
+  if(!(b->sev_mask & sel_sev_mask))
+    return 0;
+  if((sel_from_set && b->t_max < sel_from) || (sel_to_set && b->t_min > sel_to))
+    return 0;
+  if(n_sel_ids == 0)
+    return 1;
+  for(i = 0; i < n_ids; i++)
+    if((b->bloom[UVM_MSG_LOG_BLOOM_1(ids[i]) / 8] & (1 << (UVM_MSG_LOG_BLOOM_1(ids[i]) % 8))) &&
+       (b->bloom[UVM_MSG_LOG_BLOOM_2(ids[i]) / 8] & (1 << (UVM_MSG_LOG_BLOOM_2(ids[i]) % 8))))
+      return 1;
+  return 0;
+}
+
+
+//--------------------------------------------------------------------
+// query_log
+//
+// Prints the selected messages of ~name~, reading only the blocks of
+// the index that may hold them, and then whatever was appended after
+// the log was indexed.
+//--------------------------------------------------------------------
+static void query_log(const char *name, int use_index)
+{
+  unsigned *ids = (unsigned*) xrealloc(NULL, (n_sel_ids+1) * sizeof(unsigned));
+  unsigned n_ids = 0;
+  unsigned i, j, session = ~0u;
+  u64 size = 0;
+
+  open_log(name);
+  if(use_index && in != stdin)
+    size = read_index();
+
+  if(size != 0) {
+    for(i = 0; i < n_blocks; i++) {
+      block_t *b = &blocks[i];
+      if(b->session != session) {
+        session = b->session;
+        enter_session(&sessions[session]);
+        n_ids = 0;
+        for(j = 1; j <= cur->n_strs && n_ids < n_sel_ids; j++)
+          if(str_is_id[j])
+            ids[n_ids++] = j;
+      }
+      if(!block_selected(b, ids, n_ids))
+        continue;
+      fseeko(in, (off_t) b->offset, SEEK_SET);
+      pos = b->offset;
+      scan(b->end, 1, 0);
+    }
+    if(n_sessions != 0)
+      enter_session(&sessions[n_sessions-1]);
+    fseeko(in, (off_t) size, SEEK_SET);
+    pos = size;
+  }
+  scan(0, 0, 0);
+
+  close_log();
+  free(ids);
+}
+
+
+//--------------------------------------------------------------------
+// usage
+//--------------------------------------------------------------------
+static void usage(void)
+{
+  fprintf(stderr,
+          "usage: uvm_msg_log -index file ...\n"
+          "       uvm_msg_log [-severity SEV[,SEV...]] [-id ID] [-name GLOB] [-message GLOB]\n"
+          "                   [-from TIME] [-to TIME] [-count] [-noindex] [file ...]\n");
+  exit(2);
+}
+
+
+//--------------------------------------------------------------------
+// parse_severities
+//--------------------------------------------------------------------
+static void parse_severities(const char *arg)
+{
+  static int given = 0;
+  char *list = (char*) xrealloc(NULL, strlen(arg)+1);
+  char *sev;
+  int i;
+
+  if(!given)
+    sel_sev_mask = 0;
+  given = 1;
+
+  strcpy(list, arg);
+  for(sev = strtok(list, ","); sev != NULL; sev = strtok(NULL, ",")) {
+    for(i = 0; i < 4; i++)
+      if(strcasecmp(sev, sev_names[i]) == 0 || strcasecmp(sev, sev_names[i]+4) == 0)
+        break;
+    if(i == 4) {
+      fprintf(stderr, "uvm_msg_log: unknown severity %s\n", sev);
+      exit(2);
+    }
+    sel_sev_mask |= 1u << i;
+  }
+  free(list);
+}
+
+
+//--------------------------------------------------------------------
+// parse_time
+//--------------------------------------------------------------------
+static double parse_time(const char *arg)
+{
+  char *end;
+  double t = strtod(arg, &end);
+  if(*arg == 0 || *end != 0) {
+    fprintf(stderr, "uvm_msg_log: invalid time %s\n", arg);
+    exit(2);
+  }
+  return t;
+}
+
+
+//--------------------------------------------------------------------
+// main
+//--------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  const char **files = (const char**) xrealloc(NULL, argc * sizeof(char*));
+  int n_files = 0;
+  int indexing = 0, use_index = 1;
+  int i;
+
+  for(i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    int has_value = i+1 < argc;
+    if(strcmp(arg, "-index") == 0)
+      indexing = 1;
+    else if(strcmp(arg, "-noindex") == 0)
+      use_index = 0;
+    else if(strcmp(arg, "-count") == 0)
+      count_only = 1;
+    else if(strcmp(arg, "-severity") == 0 && has_value)
+      parse_severities(argv[++i]);
+    else if(strcmp(arg, "-id") == 0 && has_value) {
+      sel_ids = (const char**) xrealloc(sel_ids, (n_sel_ids+1) * sizeof(char*));
+      sel_ids[n_sel_ids++] = argv[++i];
+    }
+    else if(strcmp(arg, "-name") == 0 && has_value)
+      sel_name = argv[++i];
+    else if(strcmp(arg, "-message") == 0 && has_value)
+      sel_message = argv[++i];
+    else if(strcmp(arg, "-from") == 0 && has_value) {
+      sel_from = parse_time(argv[++i]);
+      sel_from_set = 1;
+    }
+    else if(strcmp(arg, "-to") == 0 && has_value) {
+      sel_to = parse_time(argv[++i]);
+      sel_to_set = 1;
+    }
+    else if(arg[0] == '-' && arg[1] != 0)
+      usage();
+    else
+      files[n_files++] = arg;
+  }
+
+  if(indexing) {
+    if(n_files == 0)
+      usage();
+    for(i = 0; i < n_files; i++)
+      index_log(files[i]);
+    return 0;
+  }
+
+  if(n_files == 0)
+    files[n_files++] = "-";
+  for(i = 0; i < n_files; i++)
+    query_log(files[i], use_index);
+  if(count_only)
+    printf("%llu\n", count);
+  return 0;
+}
@@ -0,0 +1,506 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+
+#include "uvm_dpi.h"
+#include "uvm_bin_tr.h"
+
+
+// Size of the write buffer of each database
+#define UVM_BIN_TR_BUF_SIZE (1 << 20)
+
+typedef struct {
+  char     *str;
+  unsigned  id;
+} uvm_bin_tr_name;
+
+typedef struct {
+  FILE            *fp;
+  unsigned char   *buf;
+  size_t           len;
+  uvm_bin_tr_name *names;     // open addressed table of interned names
+  size_t           max_names; // power of two
+  size_t           n_names;
+} uvm_bin_tr_db;
+
+static uvm_bin_tr_db **uvm_bin_tr_dbs = NULL;
+static int uvm_bin_tr_n_dbs = 0;
+static int uvm_bin_tr_exit_set = 0;
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_error
+//--------------------------------------------------------------------
+static void uvm_bin_tr_error(const char *msg)
+{
+  m_uvm_report_dpi(M_UVM_ERROR,
+                   (char*) "UVM/DPI/BIN_TR",
+                   (char*) msg,
+                   M_UVM_NONE,
+                   (char*)__FILE__,
+                   __LINE__);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_get_db
+//--------------------------------------------------------------------
+static uvm_bin_tr_db *uvm_bin_tr_get_db(int db)
+{
+  if(db < 0 || db >= uvm_bin_tr_n_dbs)
+    return NULL;
+  return uvm_bin_tr_dbs[db];
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_flush_db
+//--------------------------------------------------------------------
+static void uvm_bin_tr_flush_db(uvm_bin_tr_db *d)
+{
+  if(d->len) {
+    fwrite(d->buf, 1, d->len, d->fp);
+    d->len = 0;
+  }
+  fflush(d->fp);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_at_exit
+//
+// Databases left open when the simulator exits are flushed, so that
+// no recorded data is lost with the buffer.
+//--------------------------------------------------------------------
+static void uvm_bin_tr_at_exit(void)
+{
+  int i;
+  for(i = 0; i < uvm_bin_tr_n_dbs; i++)
+    if(uvm_bin_tr_dbs[i] != NULL)
+      uvm_bin_tr_flush_db(uvm_bin_tr_dbs[i]);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_put
+//
+// Appends ~n~ bytes to the buffer of ~d~, flushing it first when they
+// do not fit.
+//--------------------------------------------------------------------
+static void uvm_bin_tr_put(uvm_bin_tr_db *d, const void *p, size_t n)
+{
+  if(d->len + n > UVM_BIN_TR_BUF_SIZE) {
+    fwrite(d->buf, 1, d->len, d->fp);
+    d->len = 0;
+    if(n > UVM_BIN_TR_BUF_SIZE) {
+      fwrite(p, 1, n, d->fp);
+      return;
+    }
+  }
+  memcpy(d->buf + d->len, p, n);
+  d->len += n;
+}
+
+static void uvm_bin_tr_put_u8(uvm_bin_tr_db *d, unsigned v)
+{
+  unsigned char b = (unsigned char) v;
+  uvm_bin_tr_put(d, &b, 1);
+}
+
+static void uvm_bin_tr_put_u32(uvm_bin_tr_db *d, unsigned v)
+{
+  unsigned char b[4];
+  b[0] = (unsigned char) v;
+  b[1] = (unsigned char) (v >> 8);
+  b[2] = (unsigned char) (v >> 16);
+  b[3] = (unsigned char) (v >> 24);
+  uvm_bin_tr_put(d, b, 4);
+}
+
+static void uvm_bin_tr_put_f64(uvm_bin_tr_db *d, double v)
+{
+  unsigned long long u;
+  unsigned char b[8];
+  int i;
+  memcpy(&u, &v, 8);
+  for(i = 0; i < 8; i++)
+    b[i] = (unsigned char) (u >> (8*i));
+  uvm_bin_tr_put(d, b, 8);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_intern
+//
+// Returns the id of ~str~, writing a STRING record the first time it
+// is seen.  Returns 0 for the empty string; ids start at 1.
+//--------------------------------------------------------------------
+static unsigned uvm_bin_tr_intern(uvm_bin_tr_db *d, const char *str)
+{
+  unsigned long h = 5381;
+  const char *p;
+  size_t i, len;
+
+  if(str == NULL || *str == 0)
+    return 0;
+
+  for(p = str; *p; p++)
+    h = h*33 + (unsigned char) *p;
+  len = p - str;
+
+  if(2*(d->n_names+1) > d->max_names) {
+    size_t n = d->max_names ? 2*d->max_names : 1024;
+    uvm_bin_tr_name *t = (uvm_bin_tr_name*) calloc(n, sizeof(uvm_bin_tr_name));
+    if(t == NULL) {
+      uvm_bin_tr_error("out of memory interning a string");
+      return 0;
+    }
+    for(i = 0; i < d->max_names; i++) {
+      unsigned long h2 = 5381;
+      size_t j;
+      if(d->names[i].str == NULL)
+        continue;
+      for(p = d->names[i].str; *p; p++)
+        h2 = h2*33 + (unsigned char) *p;
+      for(j = h2 & (n-1); t[j].str != NULL; j = (j+1) & (n-1))
+        ;
+      t[j] = d->names[i];
+    }
+    free(d->names);
+    d->names = t;
+    d->max_names = n;
+  }
+
+  for(i = h & (d->max_names-1); d->names[i].str != NULL; i = (i+1) & (d->max_names-1))
+    if(strcmp(d->names[i].str, str) == 0)
+      return d->names[i].id;
+
+  d->names[i].str = (char*) malloc(len+1);
+  if(d->names[i].str == NULL) {
+    uvm_bin_tr_error("out of memory interning a string");
+    return 0;
+  }
+  memcpy(d->names[i].str, str, len+1);
+  d->names[i].id = (unsigned) ++d->n_names;
+
+  uvm_bin_tr_put_u8(d, UVM_BIN_TR_STRING);
+  uvm_bin_tr_put_u32(d, d->names[i].id);
+  uvm_bin_tr_put_u32(d, (unsigned) len);
+  uvm_bin_tr_put(d, str, len);
+  return d->names[i].id;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_open_file
+//
+// Opens ~filename~ for appending with an empty buffer and string table.
+// ~what~ names the kind of file in error messages.  Returns a handle,
+// or -1 on failure.  The message log of uvm_msg_log.c is opened with
+// this too.
+//--------------------------------------------------------------------
+static int uvm_bin_tr_open_file(const char *filename, const char *what)
+{
+  char msg[1024];
+  uvm_bin_tr_db *d;
+  int db;
+
+  for(db = 0; db < uvm_bin_tr_n_dbs; db++)
+    if(uvm_bin_tr_dbs[db] == NULL)
+      break;
+  if(db == uvm_bin_tr_n_dbs) {
+    uvm_bin_tr_db **tmp = (uvm_bin_tr_db**) realloc(uvm_bin_tr_dbs, (db+1)*sizeof(uvm_bin_tr_db*));
+    if(tmp == NULL) {
+      snprintf(msg, sizeof(msg), "out of memory opening a %s", what);
+      uvm_bin_tr_error(msg);
+      return -1;
+    }
+    uvm_bin_tr_dbs = tmp;
+    uvm_bin_tr_dbs[db] = NULL;
+    uvm_bin_tr_n_dbs++;
+  }
+
+  d = (uvm_bin_tr_db*) calloc(1, sizeof(uvm_bin_tr_db));
+  if(d != NULL)
+    d->buf = (unsigned char*) malloc(UVM_BIN_TR_BUF_SIZE);
+  if(d == NULL || d->buf == NULL) {
+    if(d != NULL)
+      free(d->buf);
+    free(d);
+    snprintf(msg, sizeof(msg), "out of memory opening a %s", what);
+    uvm_bin_tr_error(msg);
+    return -1;
+  }
+
+  d->fp = fopen(filename, "ab");
+  if(d->fp == NULL) {
+    snprintf(msg, sizeof(msg), "cannot open %s '%s'", what, filename);
+    uvm_bin_tr_error(msg);
+    free(d->buf);
+    free(d);
+    return -1;
+  }
+
+  if(!uvm_bin_tr_exit_set) {
+    atexit(uvm_bin_tr_at_exit);
+    uvm_bin_tr_exit_set = 1;
+  }
+
+  uvm_bin_tr_dbs[db] = d;
+  return db;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_open
+//
+// Opens ~filename~ for appending and starts a new session in it.
+// Returns a database handle, or -1 on failure.
+//--------------------------------------------------------------------
+int uvm_bin_tr_open(const char *filename, double time_scale, int streambits)
+{
+  int db = uvm_bin_tr_open_file(filename, "transaction recording database");
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+
+  if(d == NULL)
+    return -1;
+  uvm_bin_tr_put(d, UVM_BIN_TR_MAGIC, UVM_BIN_TR_MAGIC_LEN);
+  uvm_bin_tr_put_f64(d, time_scale);
+  uvm_bin_tr_put_u32(d, (unsigned) streambits);
+  return db;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_flush
+//--------------------------------------------------------------------
+void uvm_bin_tr_flush(int db)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+  if(d != NULL)
+    uvm_bin_tr_flush_db(d);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_close
+//--------------------------------------------------------------------
+void uvm_bin_tr_close(int db)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+  size_t i;
+
+  if(d == NULL)
+    return;
+
+  uvm_bin_tr_flush_db(d);
+  fclose(d->fp);
+  for(i = 0; i < d->max_names; i++)
+    free(d->names[i].str);
+  free(d->names);
+  free(d->buf);
+  free(d);
+  uvm_bin_tr_dbs[db] = NULL;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_stream_event
+//
+// Writes a CREATE_STREAM, CLOSE_STREAM or FREE_STREAM record.
+//--------------------------------------------------------------------
+void uvm_bin_tr_stream_event(int db, int tag, double t, int stream,
+                             const char *name, const char *type_name,
+                             const char *scope)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+  unsigned n, ty, sc;
+
+  if(d == NULL)
+    return;
+  n = uvm_bin_tr_intern(d, name);
+  ty = uvm_bin_tr_intern(d, type_name);
+  sc = uvm_bin_tr_intern(d, scope);
+  uvm_bin_tr_put_u8(d, tag);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u32(d, stream);
+  uvm_bin_tr_put_u32(d, n);
+  uvm_bin_tr_put_u32(d, ty);
+  uvm_bin_tr_put_u32(d, sc);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_open_recorder
+//--------------------------------------------------------------------
+void uvm_bin_tr_open_recorder(int db, double t, int txh, int stream,
+                              const char *name, double open_time,
+                              const char *type_name)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+  unsigned n, ty;
+
+  if(d == NULL)
+    return;
+  n = uvm_bin_tr_intern(d, name);
+  ty = uvm_bin_tr_intern(d, type_name);
+  uvm_bin_tr_put_u8(d, UVM_BIN_TR_OPEN_RECORDER);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u32(d, txh);
+  uvm_bin_tr_put_u32(d, stream);
+  uvm_bin_tr_put_u32(d, n);
+  uvm_bin_tr_put_f64(d, open_time);
+  uvm_bin_tr_put_u32(d, ty);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_close_recorder
+//--------------------------------------------------------------------
+void uvm_bin_tr_close_recorder(int db, double t, int txh, double close_time)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+
+  if(d == NULL)
+    return;
+  uvm_bin_tr_put_u8(d, UVM_BIN_TR_CLOSE_RECORDER);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u32(d, txh);
+  uvm_bin_tr_put_f64(d, close_time);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_free_recorder
+//--------------------------------------------------------------------
+void uvm_bin_tr_free_recorder(int db, double t, int txh)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+
+  if(d == NULL)
+    return;
+  uvm_bin_tr_put_u8(d, UVM_BIN_TR_FREE_RECORDER);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u32(d, txh);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_put_attr
+//
+// Writes an ATTR record for the low ~numbits~ bits of ~value~.
+//--------------------------------------------------------------------
+static void uvm_bin_tr_put_attr(int db, double t, int txh, const char *name,
+                                const svLogicVecVal *value, int radix,
+                                int numbits, int flags)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+  unsigned n, mask;
+  int i, words;
+
+  if(d == NULL)
+    return;
+  if(numbits < 0)
+    numbits = 0;
+  words = (numbits+31) / 32;
+  mask = (numbits % 32) ? (1u << (numbits % 32)) - 1 : ~0u;
+
+  for(i = 0; i < words; i++)
+    if(value[i].bval & (i == words-1 ? mask : ~0u)) {
+      flags |= UVM_BIN_TR_4STATE;
+      break;
+    }
+
+  n = uvm_bin_tr_intern(d, name);
+  uvm_bin_tr_put_u8(d, UVM_BIN_TR_ATTR);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u32(d, txh);
+  uvm_bin_tr_put_u32(d, n);
+  uvm_bin_tr_put_u32(d, radix);
+  uvm_bin_tr_put_u32(d, numbits);
+  uvm_bin_tr_put_u8(d, flags);
+  for(i = 0; i < words; i++)
+    uvm_bin_tr_put_u32(d, value[i].aval & (i == words-1 ? mask : ~0u));
+  if(flags & UVM_BIN_TR_4STATE)
+    for(i = 0; i < words; i++)
+      uvm_bin_tr_put_u32(d, value[i].bval & (i == words-1 ? mask : ~0u));
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_attr
+//--------------------------------------------------------------------
+void uvm_bin_tr_attr(int db, double t, int txh, const char *name,
+                     const svLogicVecVal *value, int radix, int numbits)
+{
+  uvm_bin_tr_put_attr(db, t, txh, name, value, radix, numbits, 0);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_attr_int
+//--------------------------------------------------------------------
+void uvm_bin_tr_attr_int(int db, double t, int txh, const char *name,
+                         const svLogicVecVal *value, int radix, int numbits)
+{
+  uvm_bin_tr_put_attr(db, t, txh, name, value, radix, numbits, UVM_BIN_TR_INTEGRAL);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_attr_string
+//--------------------------------------------------------------------
+void uvm_bin_tr_attr_string(int db, double t, int txh, const char *name,
+                            const char *value, int radix, int numbits)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+  unsigned n;
+  size_t len = value ? strlen(value) : 0;
+
+  if(d == NULL)
+    return;
+  n = uvm_bin_tr_intern(d, name);
+  uvm_bin_tr_put_u8(d, UVM_BIN_TR_ATTR_STRING);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u32(d, txh);
+  uvm_bin_tr_put_u32(d, n);
+  uvm_bin_tr_put_u32(d, radix);
+  uvm_bin_tr_put_u32(d, numbits);
+  uvm_bin_tr_put_u32(d, (unsigned) len);
+  uvm_bin_tr_put(d, value, len);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bin_tr_link
+//--------------------------------------------------------------------
+void uvm_bin_tr_link(int db, double t, int txh1, int txh2, const char *relation)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(db);
+  unsigned r;
+
+  if(d == NULL)
+    return;
+  r = uvm_bin_tr_intern(d, relation);
+  uvm_bin_tr_put_u8(d, UVM_BIN_TR_LINK);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u32(d, txh1);
+  uvm_bin_tr_put_u32(d, txh2);
+  uvm_bin_tr_put_u32(d, r);
+}
@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+//
+// Record layout of the binary transaction database written by
+// uvm_bin_tr.c for uvm_bin_tr_database, and read back by
+// bin/uvm_bin_tr_dump.c.  This header does not depend on the
+// simulator, so the reader can be built on its own.
+//
+// A file is a sequence of sessions, one per open of the database.
+// Each session starts with the magic string, a f64 time scale (the
+// value of %0t for a time of 1, used to print times as %0t does) and
+// a u32 holding UVM_STREAMBITS.  Records follow, each starting with a
+// u8 tag.  All numbers are little endian; f64 is an IEEE double.
+//
+//  STRING          u32 id, u32 len, len bytes
+//  CREATE_STREAM   f64 time, u32 stream, u32 name, u32 type, u32 scope
+//  CLOSE_STREAM    (as CREATE_STREAM)
+//  FREE_STREAM     (as CREATE_STREAM)
+//  OPEN_RECORDER   f64 time, u32 txh, u32 stream, u32 name,
+//                  f64 open_time, u32 type
+//  CLOSE_RECORDER  f64 time, u32 txh, f64 close_time
+//  FREE_RECORDER   f64 time, u32 txh
+//  ATTR            f64 time, u32 txh, u32 name, u32 radix, u32 numbits,
+//                  u8 flags, (numbits+31)/32 u32 aval words, then as
+//                  many bval words if UVM_BIN_TR_4STATE is set
+//  ATTR_STRING     f64 time, u32 txh, u32 name, u32 radix, u32 numbits,
+//                  u32 len, len bytes of already formatted value
+//  LINK            f64 time, u32 txh1, u32 txh2, u32 relation
+//
+// Names, types, scopes and relations are interned: the STRING record
+// that defines an id is written before its first use, and ids restart
+// with each session.
+//
+
+#ifndef UVM_BIN_TR__H
+#define UVM_BIN_TR__H
+
+#define UVM_BIN_TR_MAGIC      "UVMBTR1"
+#define UVM_BIN_TR_MAGIC_LEN  8
+
+#define UVM_BIN_TR_STRING          1
+#define UVM_BIN_TR_CREATE_STREAM   2
+#define UVM_BIN_TR_CLOSE_STREAM    3
+#define UVM_BIN_TR_FREE_STREAM     4
+#define UVM_BIN_TR_OPEN_RECORDER   5
+#define UVM_BIN_TR_CLOSE_RECORDER  6
+#define UVM_BIN_TR_FREE_RECORDER   7
+#define UVM_BIN_TR_ATTR            8
+#define UVM_BIN_TR_ATTR_STRING     9
+#define UVM_BIN_TR_LINK           10
+
+// ATTR flags
+#define UVM_BIN_TR_4STATE    1  // bval words follow the aval words
+#define UVM_BIN_TR_INTEGRAL  2  // value was a 64 bit uvm_integral_t
+
+#endif
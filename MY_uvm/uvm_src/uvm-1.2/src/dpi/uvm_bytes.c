@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+
+#include "uvm_dpi.h"
+
+
+// Modes of uvm_bytes_copy; they may be combined
+#define UVM_BYTES_BITREV 1  // reverse the bits of each byte
+#define UVM_BYTES_ORDREV 2  // take the source bytes last to first
+
+static unsigned char uvm_bytes_rev[256];
+static int uvm_bytes_rev_ready = 0;
+
+
+//--------------------------------------------------------------------
+// uvm_bytes_rev_init
+//--------------------------------------------------------------------
+static void uvm_bytes_rev_init(void)
+{
+  unsigned int i, j;
+  unsigned char r;
+
+  for(i = 0; i < 256; i++) {
+    r = 0;
+    for(j = 0; j < 8; j++)
+      if(i & (1u << j))
+        r |= (unsigned char) (0x80u >> j);
+    uvm_bytes_rev[i] = r;
+  }
+  uvm_bytes_rev_ready = 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bytes_elem
+//
+// Address of element ~idx~ (counted from the low bound) of an open
+// array, for simulators that do not lay the array out in C order.
+//--------------------------------------------------------------------
+static unsigned char* uvm_bytes_elem(const svOpenArrayHandle h, int idx)
+{
+  return (unsigned char*) svGetArrElemPtr1(h, svLow(h, 1) + idx);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_bytes_copy
+//
+// Copies ~n~ bytes from ~src~, starting at ~src_off~, to ~dst~,
+// starting at ~dst_off~.  With UVM_BYTES_ORDREV, dst[dst_off+k] is
+// taken from src[src_off+n-1-k]; with UVM_BYTES_BITREV, the bits of
+// each byte are reversed on the way.
+//--------------------------------------------------------------------
+static void uvm_bytes_copy(const svOpenArrayHandle dst, int dst_off,
+                           const svOpenArrayHandle src, int src_off,
+                           int n, int mode)
+{
+  unsigned char *d, *s;
+  int k, from;
+
+  if(n <= 0)
+    return;
+
+  if(dst_off < 0 || src_off < 0 ||
+     dst_off > svSize(dst, 1) - n || src_off > svSize(src, 1) - n) {
+    m_uvm_report_dpi(M_UVM_ERROR,
+                     (char*) "UVM/DPI/BYTES",
+                     (char*) "byte copy is out of the bounds of its arrays",
+                     M_UVM_NONE,
+                     (char*)__FILE__,
+                     __LINE__);
+    return;
+  }
+
+  if(!uvm_bytes_rev_ready)
+    uvm_bytes_rev_init();
+
+  d = (unsigned char*) svGetArrayPtr(dst);
+  s = (unsigned char*) svGetArrayPtr(src);
+
+  if(d != NULL && s != NULL) {
+    d += dst_off;
+    s += src_off;
+    switch(mode) {
+      case 0:
+        memmove(d, s, n);
+        break;
+      case UVM_BYTES_BITREV:
+        for(k = 0; k < n; k++)
+          d[k] = uvm_bytes_rev[s[k]];
+        break;
+      case UVM_BYTES_ORDREV:
+        for(k = 0; k < n; k++)
+          d[k] = s[n-1-k];
+        break;
+      default:
+        for(k = 0; k < n; k++)
+          d[k] = uvm_bytes_rev[s[n-1-k]];
+        break;
+    }
+    return;
+  }
+
+  for(k = 0; k < n; k++) {
+    from = (mode & UVM_BYTES_ORDREV) ? src_off+n-1-k : src_off+k;
+    s = uvm_bytes_elem(src, from);
+    d = uvm_bytes_elem(dst, dst_off+k);
+    *d = (mode & UVM_BYTES_BITREV) ? uvm_bytes_rev[*s] : *s;
+  }
+}
+
+
+//--------------------------------------------------------------------
+// uvm_pack_bytes_copy
+//
+// byte to byte unsigned, used by uvm_packer::pack_bytes
+//--------------------------------------------------------------------
+void uvm_pack_bytes_copy(const svOpenArrayHandle dst, int dst_off,
+                         const svOpenArrayHandle src, int src_off,
+                         int n, int mode)
+{
+  uvm_bytes_copy(dst, dst_off, src, src_off, n, mode);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_unpack_bytes_copy
+//
+// byte unsigned to byte, used by uvm_packer::unpack_bytes
+//--------------------------------------------------------------------
+void uvm_unpack_bytes_copy(const svOpenArrayHandle dst, int dst_off,
+                           const svOpenArrayHandle src, int src_off,
+                           int n, int mode)
+{
+  uvm_bytes_copy(dst, dst_off, src, src_off, n, mode);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_stream_bytes_copy
+//
+// byte unsigned to byte unsigned, used by uvm_packer::get_bytes and
+// uvm_packer::put_bytes
+//--------------------------------------------------------------------
+void uvm_stream_bytes_copy(const svOpenArrayHandle dst, int dst_off,
+                           const svOpenArrayHandle src, int src_off,
+                           int n, int mode)
+{
+  uvm_bytes_copy(dst, dst_off, src, src_off, n, mode);
+}
@@ -36,6 +36,13 @@ extern "C" {
 #include "uvm_regex.cc"
 #include "uvm_hdl.c"
 #include "uvm_svcmd_dpi.c"
+#include "uvm_levenshtein.c"
+#include "uvm_hash.c"
+#include "uvm_glob.c"
+#include "uvm_bytes.c"
+#include "uvm_bin_tr.c"
+#include "uvm_log_sink.c"
+#include "uvm_msg_log.c"
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,482 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+
+#include "uvm_dpi.h"
+
+
+//--------------------------------------------------------------------
+// Glob sets
+//
+// A glob set is an ordered list of glob expressions, compiled so that
+// the first expression matching a string is found in a single call.
+// Each glob is split into its literal prefix, up to the first '*', '?'
+// or '+', and the remainder.  The prefixes are stored in a trie, so
+// walking the string down the trie once yields the only globs that can
+// possibly match; the remainders of those are then tried in order.
+//
+// Globs that uvm_glob_to_re would not turn into a plain wildcard match
+// (bracketed /regex/ strings, or strings containing other regular
+// expression characters) are compiled once with regcomp() and are
+// always candidates.
+//--------------------------------------------------------------------
+
+#define UVM_GLOB_NONE 0
+#define UVM_GLOB_ALL  1
+#define UVM_GLOB_WILD 2
+#define UVM_GLOB_RE   3
+
+typedef struct uvm_glob_node {
+  char                  ch;
+  struct uvm_glob_node *child;
+  struct uvm_glob_node *sibling;
+  int                  *ends;
+  int                   n_ends;
+  int                   max_ends;
+} uvm_glob_node;
+
+typedef struct {
+  int      kind;
+  int      prefix_len;
+  char    *prefix;
+  char    *rest;
+  regex_t  re;
+} uvm_glob_pat;
+
+typedef struct {
+  int            in_use;
+  uvm_glob_pat  *pats;
+  int            n_pats;
+  int            max_pats;
+  uvm_glob_node  root;
+} uvm_glob_set;
+
+static uvm_glob_set **uvm_glob_sets = NULL;
+static int uvm_glob_n_sets = 0;
+
+static int *uvm_glob_cands = NULL;
+static int uvm_glob_max_cands = 0;
+
+
+static void uvm_glob_alloc_error(const char *where)
+{
+  m_uvm_report_dpi(M_UVM_ERROR,
+                   (char*) "UVM/DPI/GLOB_ALLOC",
+                   (char*) where,
+                   M_UVM_NONE,
+                   (char*)__FILE__,
+                   __LINE__);
+}
+
+
+static uvm_glob_set *uvm_glob_get_set(int set)
+{
+  if(set < 0 || set >= uvm_glob_n_sets || uvm_glob_sets[set] == NULL ||
+     !uvm_glob_sets[set]->in_use)
+    return NULL;
+  return uvm_glob_sets[set];
+}
+
+
+static void uvm_glob_free_node(uvm_glob_node *node)
+{
+  uvm_glob_node *c, *next;
+
+  for(c = node->child; c != NULL; c = next) {
+    next = c->sibling;
+    uvm_glob_free_node(c);
+    free(c);
+  }
+  free(node->ends);
+  node->child = NULL;
+  node->ends = NULL;
+  node->n_ends = 0;
+  node->max_ends = 0;
+}
+
+
+static int uvm_glob_add_end(uvm_glob_node *node, int index)
+{
+  int *tmp;
+
+  if(node->n_ends == node->max_ends) {
+    tmp = (int*) realloc(node->ends, (node->max_ends ? 2*node->max_ends : 4)*sizeof(int));
+    if(tmp == NULL)
+      return 0;
+    node->ends = tmp;
+    node->max_ends = node->max_ends ? 2*node->max_ends : 4;
+  }
+  node->ends[node->n_ends++] = index;
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_glob_is_wild
+//
+// Returns 1 if uvm_glob_to_re would turn glob into a regular expression
+// that only uses the '*', '?' and '+' wildcards, so that it can be
+// matched without the regex library.
+//--------------------------------------------------------------------
+static int uvm_glob_is_wild(const char *glob)
+{
+  int len = strlen(glob);
+
+  if(len > 2040)
+    return 0;
+  if(glob[0] == uvm_re_bracket_char && glob[len-1] == uvm_re_bracket_char)
+    return 0;
+  return strpbrk(glob, "^$|{}\\") == NULL;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_glob_match_rest
+//
+// Match the wildcard part of a glob, where '?' matches any single
+// character and '*' any sequence.  A '+' in the glob has already been
+// rewritten to "?*".
+//--------------------------------------------------------------------
+static int uvm_glob_match_rest(const char *p, const char *s)
+{
+  const char *star = NULL, *ss = NULL;
+
+  while(*s) {
+    if(*p == '*') {
+      star = p++;
+      ss = s;
+    }
+    else if(*p == '?' || (*p != '\0' && *p == *s)) {
+      p++;
+      s++;
+    }
+    else if(star != NULL) {
+      p = star+1;
+      s = ++ss;
+    }
+    else
+      return 0;
+  }
+  while(*p == '*')
+    p++;
+  return *p == '\0';
+}
+
+
+static int uvm_glob_match_pat(uvm_glob_pat *pat, const char *str, int len)
+{
+  switch(pat->kind) {
+  case UVM_GLOB_ALL:
+    return 1;
+  case UVM_GLOB_WILD:
+    // the literal prefix was matched by the trie walk
+    if(pat->prefix_len > len)
+      return 0;
+    return uvm_glob_match_rest(pat->rest, str + pat->prefix_len);
+  case UVM_GLOB_RE:
+    return regexec(&pat->re, str, 0, NULL, 0) == 0;
+  default:
+    return 0;
+  }
+}
+
+
+//--------------------------------------------------------------------
+// uvm_glob_set_new
+//
+// Create an empty glob set and return its handle.
+//--------------------------------------------------------------------
+int uvm_glob_set_new()
+{
+  uvm_glob_set **tmp;
+  int set;
+
+  for(set = 0; set < uvm_glob_n_sets; set++)
+    if(!uvm_glob_sets[set]->in_use)
+      break;
+
+  if(set == uvm_glob_n_sets) {
+    tmp = (uvm_glob_set**) realloc(uvm_glob_sets, (set+1)*sizeof(uvm_glob_set*));
+    if(tmp == NULL) {
+      uvm_glob_alloc_error("uvm_glob_set_new: internal memory allocation error");
+      return -1;
+    }
+    uvm_glob_sets = tmp;
+    uvm_glob_sets[set] = (uvm_glob_set*) calloc(1, sizeof(uvm_glob_set));
+    if(uvm_glob_sets[set] == NULL) {
+      uvm_glob_alloc_error("uvm_glob_set_new: internal memory allocation error");
+      return -1;
+    }
+    uvm_glob_n_sets++;
+  }
+
+  uvm_glob_sets[set]->in_use = 1;
+  return set;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_glob_set_free
+//
+// Release a glob set.  The handle may be reused by uvm_glob_set_new.
+//--------------------------------------------------------------------
+void uvm_glob_set_free(int set)
+{
+  uvm_glob_set *gs = uvm_glob_get_set(set);
+  int i;
+
+  if(gs == NULL)
+    return;
+
+  for(i = 0; i < gs->n_pats; i++) {
+    if(gs->pats[i].kind == UVM_GLOB_RE)
+      regfree(&gs->pats[i].re);
+    free(gs->pats[i].prefix);
+    free(gs->pats[i].rest);
+  }
+  free(gs->pats);
+  uvm_glob_free_node(&gs->root);
+  memset(gs, 0, sizeof(uvm_glob_set));
+}
+
+
+//--------------------------------------------------------------------
+// uvm_glob_set_add
+//
+// Append glob to the set and return its index, or -1 on error.  A glob
+// that does not compile is kept, so that indices stay in step with the
+// caller's list, but it never matches.
+//--------------------------------------------------------------------
+int uvm_glob_set_add(int set, const char *glob)
+{
+  uvm_glob_set *gs = uvm_glob_get_set(set);
+  uvm_glob_pat *pat, *tmp;
+  uvm_glob_node *node, *c;
+  const char *re, *p;
+  char *rex, *q;
+  int index, len, err;
+
+  if(gs == NULL || glob == NULL)
+    return -1;
+
+  if(gs->n_pats == gs->max_pats) {
+    tmp = (uvm_glob_pat*) realloc(gs->pats, (gs->max_pats ? 2*gs->max_pats : 4)*sizeof(uvm_glob_pat));
+    if(tmp == NULL) {
+      uvm_glob_alloc_error("uvm_glob_set_add: internal memory allocation error");
+      return -1;
+    }
+    gs->pats = tmp;
+    gs->max_pats = gs->max_pats ? 2*gs->max_pats : 4;
+  }
+
+  index = gs->n_pats;
+  pat = &gs->pats[index];
+  memset(pat, 0, sizeof(uvm_glob_pat));
+  node = &gs->root;
+
+  len = strlen(glob);
+
+  if(len == 0 || (len == 1 && *glob == uvm_re_bracket_char))
+    pat->kind = UVM_GLOB_ALL;
+
+  else if(uvm_glob_is_wild(glob)) {
+    // Walk/extend the trie along the literal prefix
+    for(p = glob; *p && *p != '*' && *p != '?' && *p != '+'; p++) {
+      for(c = node->child; c != NULL && c->ch != *p; c = c->sibling)
+        ;
+      if(c == NULL) {
+        c = (uvm_glob_node*) calloc(1, sizeof(uvm_glob_node));
+        if(c == NULL) {
+          uvm_glob_alloc_error("uvm_glob_set_add: internal memory allocation error");
+          return -1;
+        }
+        c->ch = *p;
+        c->sibling = node->child;
+        node->child = c;
+      }
+      node = c;
+    }
+    pat->prefix_len = p - glob;
+
+    pat->prefix = (char*) malloc(pat->prefix_len+1);
+    if(pat->prefix == NULL) {
+      uvm_glob_alloc_error("uvm_glob_set_add: internal memory allocation error");
+      return -1;
+    }
+    strncpy(pat->prefix, glob, pat->prefix_len);
+    pat->prefix[pat->prefix_len] = '\0';
+
+    pat->rest = (char*) malloc(2*strlen(p)+1);
+    if(pat->rest == NULL) {
+      free(pat->prefix);
+      uvm_glob_alloc_error("uvm_glob_set_add: internal memory allocation error");
+      return -1;
+    }
+    for(q = pat->rest; *p; p++) {
+      if(*p == '+') {
+        *q++ = '?';
+        *q++ = '*';
+      }
+      else
+        *q++ = *p;
+    }
+    *q = '\0';
+    pat->kind = UVM_GLOB_WILD;
+  }
+
+  else {
+    // Same conversion and bracket stripping as uvm_re_match
+    re = uvm_glob_to_re(glob);
+    len = strlen(re);
+    if(len > UVM_REGEX_MAX_LENGTH) {
+      const char* err_str = "uvm_glob_set_add : regular expression greater than max %0d: |%s|";
+      char buffer[strlen(err_str) + int_str_max(10) + strlen(re)];
+      sprintf(buffer, err_str, UVM_REGEX_MAX_LENGTH, re);
+      m_uvm_report_dpi(M_UVM_ERROR,
+                       (char*) "UVM/DPI/REGEX_MAX",
+                       &buffer[0],
+                       M_UVM_NONE,
+                       (char*)__FILE__,
+                       __LINE__);
+      pat->kind = UVM_GLOB_NONE;
+    }
+    else {
+      rex = (char*) malloc(len+1);
+      if(rex == NULL) {
+        uvm_glob_alloc_error("uvm_glob_set_add: internal memory allocation error");
+        return -1;
+      }
+      strcpy(rex, re);
+      q = rex;
+      if(len > 1 && rex[0] == uvm_re_bracket_char && rex[len-1] == uvm_re_bracket_char) {
+        rex[len-1] = '\0';
+        q++;
+      }
+      err = regcomp(&pat->re, q, REG_EXTENDED|REG_NOSUB);
+      if(err != 0) {
+        regerror(err, &pat->re, uvm_re, UVM_REGEX_MAX_LENGTH-1);
+        const char * err_str = "uvm_glob_set_add : invalid glob or regular expression: |%s||%s|";
+        char buffer[strlen(err_str) + strlen(glob) + strlen(uvm_re)];
+        sprintf(buffer, err_str, glob, uvm_re);
+        m_uvm_report_dpi(M_UVM_ERROR,
+                         (char*) "UVM/DPI/REGEX_INV",
+                         &buffer[0],
+                         M_UVM_NONE,
+                         (char*)__FILE__,
+                         __LINE__);
+        pat->kind = UVM_GLOB_NONE;
+      }
+      else
+        pat->kind = UVM_GLOB_RE;
+      free(rex);
+    }
+  }
+
+  if(!uvm_glob_add_end(node, index)) {
+    if(pat->kind == UVM_GLOB_RE)
+      regfree(&pat->re);
+    free(pat->prefix);
+    free(pat->rest);
+    uvm_glob_alloc_error("uvm_glob_set_add: internal memory allocation error");
+    return -1;
+  }
+
+  gs->n_pats++;
+  return index;
+}
+
+
+static int uvm_glob_cmp_int(const void *a, const void *b)
+{
+  return *(const int*)a - *(const int*)b;
+}
+
+
+static int uvm_glob_push_cands(uvm_glob_node *node, int start, int *n)
+{
+  int *tmp;
+  int i;
+
+  for(i = 0; i < node->n_ends; i++) {
+    if(node->ends[i] < start)
+      continue;
+    if(*n == uvm_glob_max_cands) {
+      tmp = (int*) realloc(uvm_glob_cands, (*n ? 2*(*n) : 64)*sizeof(int));
+      if(tmp == NULL)
+        return 0;
+      uvm_glob_cands = tmp;
+      uvm_glob_max_cands = *n ? 2*(*n) : 64;
+    }
+    uvm_glob_cands[(*n)++] = node->ends[i];
+  }
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_glob_set_match
+//
+// Return the index of the first glob in the set, at or after start,
+// that matches str, or -1 if there is none.
+//--------------------------------------------------------------------
+int uvm_glob_set_match(int set, const char *str, int start)
+{
+  uvm_glob_set *gs = uvm_glob_get_set(set);
+  uvm_glob_node *node, *c;
+  const char *p;
+  int i, n = 0, len, ok;
+
+  if(gs == NULL || str == NULL)
+    return -1;
+
+  if(start < 0)
+    start = 0;
+
+  len = strlen(str);
+
+  // Collect the globs whose literal prefix is a prefix of str
+  node = &gs->root;
+  ok = uvm_glob_push_cands(node, start, &n);
+  for(p = str; ok && *p; p++) {
+    for(c = node->child; c != NULL && c->ch != *p; c = c->sibling)
+      ;
+    if(c == NULL)
+      break;
+    node = c;
+    ok = uvm_glob_push_cands(node, start, &n);
+  }
+
+  if(!ok) {
+    // Out of memory for the candidate list; try every glob in order
+    for(i = start; i < gs->n_pats; i++)
+      if((gs->pats[i].kind != UVM_GLOB_WILD ||
+          strncmp(gs->pats[i].prefix, str, gs->pats[i].prefix_len) == 0) &&
+         uvm_glob_match_pat(&gs->pats[i], str, len))
+        return i;
+    return -1;
+  }
+
+  qsort(uvm_glob_cands, n, sizeof(int), uvm_glob_cmp_int);
+
+  for(i = 0; i < n; i++)
+    if(uvm_glob_match_pat(&gs->pats[uvm_glob_cands[i]], str, len))
+      return uvm_glob_cands[i];
+
+  return -1;
+}
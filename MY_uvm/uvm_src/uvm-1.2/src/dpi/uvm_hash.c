@@ -0,0 +1,81 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include "uvm_dpi.h"
+
+
+// UVM_STR_CRC_POLYNOMIAL with the low bit that uvm_oneway_hash forces on
+#define UVM_ONEWAY_CRC_POLYNOMIAL 0x04c11db7u
+
+static unsigned int uvm_oneway_crc_table[256];
+static unsigned char uvm_oneway_crc_rev[256];
+static int uvm_oneway_crc_ready = 0;
+
+
+//--------------------------------------------------------------------
+// uvm_oneway_crc_init
+//
+// Build the byte-at-a-time lookup table for the CRC, and the table of
+// bit-reversed bytes.  uvm_oneway_hash feeds the bits of each byte
+// least significant first into a register that shifts left, which is
+// the usual most-significant-first CRC applied to the reversed byte.
+//--------------------------------------------------------------------
+static void uvm_oneway_crc_init(void)
+{
+  unsigned int i, j, crc;
+  unsigned char r;
+
+  for(i = 0; i < 256; i++) {
+    crc = i << 24;
+    for(j = 0; j < 8; j++)
+      crc = (crc & 0x80000000u) ? (crc << 1) ^ UVM_ONEWAY_CRC_POLYNOMIAL : (crc << 1);
+    uvm_oneway_crc_table[i] = crc;
+
+    r = 0;
+    for(j = 0; j < 8; j++)
+      if(i & (1u << j))
+        r |= (unsigned char) (0x80u >> j);
+    uvm_oneway_crc_rev[i] = r;
+  }
+  uvm_oneway_crc_ready = 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_oneway_crc
+//
+// Return the CRC register of uvm_oneway_hash after hashing str,
+// starting from all ones.  Bit-identical to the SystemVerilog loop.
+//--------------------------------------------------------------------
+unsigned int uvm_oneway_crc(const char *str)
+{
+  unsigned int crc = 0xffffffffu;
+  const unsigned char *p;
+
+  if(!uvm_oneway_crc_ready)
+    uvm_oneway_crc_init();
+
+  if(str == NULL)
+    return crc;
+
+  for(p = (const unsigned char*) str; *p; p++)
+    crc = (crc << 8) ^ uvm_oneway_crc_table[(crc >> 24) ^ uvm_oneway_crc_rev[*p]];
+
+  return crc;
+}
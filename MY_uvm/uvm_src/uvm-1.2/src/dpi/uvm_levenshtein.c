@@ -0,0 +1,87 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+#include "uvm_dpi.h"
+
+
+//--------------------------------------------------------------------
+// uvm_levenshtein_distance
+//
+// Compute the levenshtein distance between s and t, i.e. the smallest
+// number of insertions, deletions and substitutions required to change
+// one string into the other.  A negative return value means that one or
+// both strings are empty.
+//
+// Only two rows of the distance matrix are kept.  Short strings, which
+// is what resource and type names are, are handled without allocating.
+//--------------------------------------------------------------------
+int uvm_levenshtein_distance(const char *s, const char *t)
+{
+  int n, m, i, j, cost, del, ins, sub;
+  int buf[2*128];
+  int *prev, *curr, *tmp, *mem = NULL;
+
+  if(s == NULL || t == NULL)
+    return -1;
+
+  n = strlen(s);
+  m = strlen(t);
+
+  if(n == 0 || m == 0)
+    return -1;
+
+  if(m+1 <= 128)
+    prev = &buf[0];
+  else {
+    mem = (int*) malloc(2*(m+1)*sizeof(int));
+    if(mem == NULL) {
+      m_uvm_report_dpi(M_UVM_ERROR,
+                       (char*) "UVM/DPI/LEVENSHTEIN_ALLOC",
+                       (char*) "uvm_levenshtein_distance: internal memory allocation error",
+                       M_UVM_NONE,
+                       (char*)__FILE__,
+                       __LINE__);
+      return -1;
+    }
+    prev = mem;
+  }
+  curr = prev + (m+1);
+
+  for(j = 0; j <= m; j++)
+    prev[j] = j;
+
+  for(i = 1; i <= n; i++) {
+    curr[0] = i;
+    for(j = 1; j <= m; j++) {
+      cost = (s[i-1] != t[j-1]);
+      del = prev[j] + 1;
+      ins = curr[j-1] + 1;
+      sub = prev[j-1] + cost;
+      curr[j] = (del < ins) ? del : ins;
+      if(sub < curr[j])
+        curr[j] = sub;
+    }
+    tmp = prev; prev = curr; curr = tmp;
+  }
+
+  i = prev[m];
+  if(mem != NULL)
+    free(mem);
+  return i;
+}
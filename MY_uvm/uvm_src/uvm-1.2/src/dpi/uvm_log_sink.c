@@ -0,0 +1,490 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+//
+// Buffered log file writer used by uvm_default_report_server when
+// +UVM_LOG_SINK=native is given.
+//
+// A report file handle (a multi-channel descriptor or a file
+// descriptor returned by $fopen) is attached by looking up the names
+// of its files with vpi_mcd_name and opening them for appending.
+// Messages are then copied into a large buffer per file, which is
+// written when full, on uvm_log_sink_flush, at the end of simulation
+// and at exit.  When threads are enabled the full buffers are written
+// by a background thread, which also writes partly filled buffers
+// every UVM_LOG_SINK_PERIOD_MS milliseconds.
+//
+// Define UVM_LOG_SINK_NO_THREADS to build without pthreads.
+//
+
+#if defined(_WIN32) && !defined(UVM_LOG_SINK_NO_THREADS)
+#define UVM_LOG_SINK_NO_THREADS
+#endif
+
+#ifndef UVM_LOG_SINK_NO_THREADS
+#include <pthread.h>
+#include <sys/time.h>
+#include <errno.h>
+#endif
+
+#include "uvm_dpi.h"
+
+// Size of the buffer of each file
+#define UVM_LOG_SINK_BUF_SIZE (1 << 20)
+
+// Period of the background flush of partly filled buffers
+#define UVM_LOG_SINK_PERIOD_MS 200
+
+typedef struct {
+  char   *name;
+  FILE   *fp;
+  char   *buf;      // being filled by the simulator
+  size_t  len;
+  char   *out;      // being written by the writer thread
+  size_t  out_len;
+} uvm_log_sink_file;
+
+typedef struct {
+  int                 handle;
+  int                 n_files;
+  uvm_log_sink_file **files;
+} uvm_log_sink_handle;
+
+static uvm_log_sink_file   **uvm_log_sink_files = NULL;
+static int                   uvm_log_sink_n_files = 0;
+static uvm_log_sink_handle  *uvm_log_sink_handles = NULL;
+static int                   uvm_log_sink_n_handles = 0;
+static int                   uvm_log_sink_last = -1;
+static int                   uvm_log_sink_threaded = 0;
+static int                   uvm_log_sink_hooked = 0;
+
+#ifndef UVM_LOG_SINK_NO_THREADS
+static pthread_mutex_t uvm_log_sink_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  uvm_log_sink_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  uvm_log_sink_done = PTHREAD_COND_INITIALIZER;
+static pthread_t       uvm_log_sink_thread;
+static int             uvm_log_sink_running = 0;
+static int             uvm_log_sink_stop = 0;
+#define UVM_LOG_SINK_LOCK()   pthread_mutex_lock(&uvm_log_sink_mutex)
+#define UVM_LOG_SINK_UNLOCK() pthread_mutex_unlock(&uvm_log_sink_mutex)
+#else
+#define UVM_LOG_SINK_LOCK()
+#define UVM_LOG_SINK_UNLOCK()
+#endif
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_error
+//--------------------------------------------------------------------
+static void uvm_log_sink_error(int severity, const char *msg)
+{
+  m_uvm_report_dpi(severity,
+                   (char*) "UVM/DPI/LOG_SINK",
+                   (char*) msg,
+                   M_UVM_NONE,
+                   (char*)__FILE__,
+                   __LINE__);
+}
+
+
+#ifndef UVM_LOG_SINK_NO_THREADS
+
+//--------------------------------------------------------------------
+// uvm_log_sink_swap
+//
+// Hands the filled part of the buffer of ~f~ to the writer thread.
+// Called with the lock held; waits for the previous hand-off of ~f~
+// to be written first.
+//--------------------------------------------------------------------
+static void uvm_log_sink_swap(uvm_log_sink_file *f)
+{
+  char *tmp;
+  while(f->out_len)
+    pthread_cond_wait(&uvm_log_sink_done, &uvm_log_sink_mutex);
+  if(f->len == 0)
+    return;
+  tmp = f->out;
+  f->out = f->buf;
+  f->out_len = f->len;
+  f->buf = tmp;
+  f->len = 0;
+  pthread_cond_signal(&uvm_log_sink_work);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_writer
+//
+// Body of the writer thread.
+//--------------------------------------------------------------------
+static void *uvm_log_sink_writer(void *arg)
+{
+  (void) arg;
+  UVM_LOG_SINK_LOCK();
+  while(1) {
+    uvm_log_sink_file *f = NULL;
+    int i;
+
+    for(i = 0; i < uvm_log_sink_n_files; i++)
+      if(uvm_log_sink_files[i]->out_len) {
+        f = uvm_log_sink_files[i];
+        break;
+      }
+
+    if(f != NULL) {
+      char *data = f->out;
+      size_t n = f->out_len;
+      FILE *fp = f->fp;
+      UVM_LOG_SINK_UNLOCK();
+      fwrite(data, 1, n, fp);
+      fflush(fp);
+      UVM_LOG_SINK_LOCK();
+      f->out_len = 0;
+      pthread_cond_broadcast(&uvm_log_sink_done);
+    }
+    else if(uvm_log_sink_stop)
+      break;
+    else {
+      struct timeval now;
+      struct timespec until;
+      gettimeofday(&now, NULL);
+      until.tv_sec = now.tv_sec + (now.tv_usec/1000 + UVM_LOG_SINK_PERIOD_MS) / 1000;
+      until.tv_nsec = ((now.tv_usec/1000 + UVM_LOG_SINK_PERIOD_MS) % 1000) * 1000000;
+      if(pthread_cond_timedwait(&uvm_log_sink_work, &uvm_log_sink_mutex, &until) == ETIMEDOUT)
+        for(i = 0; i < uvm_log_sink_n_files; i++)
+          if(uvm_log_sink_files[i]->len && !uvm_log_sink_files[i]->out_len) {
+            char *tmp;
+            f = uvm_log_sink_files[i];
+            tmp = f->out;
+            f->out = f->buf;
+            f->out_len = f->len;
+            f->buf = tmp;
+            f->len = 0;
+          }
+    }
+  }
+  UVM_LOG_SINK_UNLOCK();
+  return NULL;
+}
+
+#endif
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_flush_file
+//
+// Writes out everything buffered for ~f~.  Called with the lock held.
+//--------------------------------------------------------------------
+static void uvm_log_sink_flush_file(uvm_log_sink_file *f)
+{
+#ifndef UVM_LOG_SINK_NO_THREADS
+  if(uvm_log_sink_running) {
+    uvm_log_sink_swap(f);
+    while(f->out_len)
+      pthread_cond_wait(&uvm_log_sink_done, &uvm_log_sink_mutex);
+    return;
+  }
+#endif
+  if(f->len) {
+    fwrite(f->buf, 1, f->len, f->fp);
+    f->len = 0;
+  }
+  fflush(f->fp);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_detach_all
+//
+// Flushes and closes all files, and forgets all handles.  Called with
+// the lock held.
+//--------------------------------------------------------------------
+static void uvm_log_sink_detach_all(void)
+{
+  int i;
+
+  for(i = 0; i < uvm_log_sink_n_files; i++)
+    uvm_log_sink_flush_file(uvm_log_sink_files[i]);
+
+  for(i = 0; i < uvm_log_sink_n_files; i++) {
+    uvm_log_sink_file *f = uvm_log_sink_files[i];
+    fclose(f->fp);
+    free(f->name);
+    free(f->buf);
+    free(f->out);
+    free(f);
+  }
+  uvm_log_sink_n_files = 0;
+
+  for(i = 0; i < uvm_log_sink_n_handles; i++)
+    free(uvm_log_sink_handles[i].files);
+  uvm_log_sink_n_handles = 0;
+  uvm_log_sink_last = -1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_shutdown
+//
+// Called at the end of simulation and at exit: writes out all buffers
+// and stops the writer thread.
+//--------------------------------------------------------------------
+static void uvm_log_sink_shutdown(void)
+{
+  UVM_LOG_SINK_LOCK();
+  uvm_log_sink_detach_all();
+#ifndef UVM_LOG_SINK_NO_THREADS
+  if(uvm_log_sink_running) {
+    uvm_log_sink_stop = 1;
+    pthread_cond_signal(&uvm_log_sink_work);
+    UVM_LOG_SINK_UNLOCK();
+    pthread_join(uvm_log_sink_thread, NULL);
+    UVM_LOG_SINK_LOCK();
+    uvm_log_sink_running = 0;
+    uvm_log_sink_stop = 0;
+  }
+#endif
+  UVM_LOG_SINK_UNLOCK();
+}
+
+static PLI_INT32 uvm_log_sink_end_of_sim(p_cb_data cb)
+{
+  (void) cb;
+  uvm_log_sink_shutdown();
+  return 0;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_init
+//
+// Selects whether full buffers are written by a background thread.
+// Returns 1 on success.
+//--------------------------------------------------------------------
+int uvm_log_sink_init(int threaded)
+{
+  if(!uvm_log_sink_hooked) {
+    s_cb_data cb;
+    memset(&cb, 0, sizeof(cb));
+    cb.reason = cbEndOfSimulation;
+    cb.cb_rtn = uvm_log_sink_end_of_sim;
+    vpi_register_cb(&cb);
+    atexit(uvm_log_sink_shutdown);
+    uvm_log_sink_hooked = 1;
+  }
+
+#ifndef UVM_LOG_SINK_NO_THREADS
+  UVM_LOG_SINK_LOCK();
+  if(threaded && !uvm_log_sink_running) {
+    if(pthread_create(&uvm_log_sink_thread, NULL, uvm_log_sink_writer, NULL) == 0)
+      uvm_log_sink_running = 1;
+    else
+      uvm_log_sink_error(M_UVM_WARNING, "cannot start the log writer thread, writing from the simulator thread");
+  }
+  UVM_LOG_SINK_UNLOCK();
+#else
+  if(threaded)
+    uvm_log_sink_error(M_UVM_WARNING, "the log sink was built without threads, writing from the simulator thread");
+#endif
+  uvm_log_sink_threaded = threaded;
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_open_file
+//
+// Returns the open file named ~name~, opening it for appending if it
+// is not open yet.  Called with the lock held.
+//--------------------------------------------------------------------
+static uvm_log_sink_file *uvm_log_sink_open_file(const char *name)
+{
+  uvm_log_sink_file *f;
+  uvm_log_sink_file **tmp;
+  int i;
+
+  for(i = 0; i < uvm_log_sink_n_files; i++)
+    if(strcmp(uvm_log_sink_files[i]->name, name) == 0)
+      return uvm_log_sink_files[i];
+
+  tmp = (uvm_log_sink_file**) realloc(uvm_log_sink_files,
+                                      (uvm_log_sink_n_files+1) * sizeof(uvm_log_sink_file*));
+  if(tmp == NULL)
+    return NULL;
+  uvm_log_sink_files = tmp;
+
+  f = (uvm_log_sink_file*) calloc(1, sizeof(uvm_log_sink_file));
+  if(f == NULL)
+    return NULL;
+  f->name = (char*) malloc(strlen(name)+1);
+  f->buf = (char*) malloc(UVM_LOG_SINK_BUF_SIZE);
+  if(uvm_log_sink_threaded)
+    f->out = (char*) malloc(UVM_LOG_SINK_BUF_SIZE);
+  if(f->name == NULL || f->buf == NULL || (uvm_log_sink_threaded && f->out == NULL) ||
+     (f->fp = fopen(name, "ab")) == NULL) {
+    free(f->name);
+    free(f->buf);
+    free(f->out);
+    free(f);
+    return NULL;
+  }
+  strcpy(f->name, name);
+  uvm_log_sink_files[uvm_log_sink_n_files++] = f;
+  return f;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_attach
+//
+// Attaches the report file handle ~handle~ to the sink.  Returns 1 if
+// the messages written to ~handle~ can be handed to uvm_log_sink_write,
+// 0 if they have to be written by the simulator.  The caller flushes
+// the handle first, so that the files continue where the simulator
+// left off.
+//--------------------------------------------------------------------
+int uvm_log_sink_attach(int handle)
+{
+  uvm_log_sink_handle *h;
+  uvm_log_sink_file *files[31];
+  int n = 0, i;
+  unsigned u = (unsigned) handle;
+
+  // stdin, stdout and stderr, or an mcd including stdout, stay with
+  // the simulator
+  if(u == 0 || ((u & 0x80000000u) ? (u & 0x7fffffffu) < 3 : (u & 1)))
+    return 0;
+
+  UVM_LOG_SINK_LOCK();
+  for(i = 0; i < uvm_log_sink_n_handles; i++)
+    if(uvm_log_sink_handles[i].handle == handle) {
+      UVM_LOG_SINK_UNLOCK();
+      return 1;
+    }
+
+  if(u & 0x80000000u) {
+    char *name = vpi_mcd_name(u);
+    if(name == NULL || (files[n++] = uvm_log_sink_open_file(name)) == NULL) {
+      UVM_LOG_SINK_UNLOCK();
+      return 0;
+    }
+  }
+  else
+    for(i = 1; i < 31; i++)
+      if(u & (1u << i)) {
+        char *name = vpi_mcd_name(1u << i);
+        if(name == NULL || (files[n++] = uvm_log_sink_open_file(name)) == NULL) {
+          UVM_LOG_SINK_UNLOCK();
+          return 0;
+        }
+      }
+
+  h = (uvm_log_sink_handle*) realloc(uvm_log_sink_handles,
+                                     (uvm_log_sink_n_handles+1) * sizeof(uvm_log_sink_handle));
+  if(h == NULL) {
+    UVM_LOG_SINK_UNLOCK();
+    return 0;
+  }
+  uvm_log_sink_handles = h;
+  h = &uvm_log_sink_handles[uvm_log_sink_n_handles];
+  h->files = (uvm_log_sink_file**) malloc(n * sizeof(uvm_log_sink_file*));
+  if(h->files == NULL) {
+    UVM_LOG_SINK_UNLOCK();
+    return 0;
+  }
+  memcpy(h->files, files, n * sizeof(uvm_log_sink_file*));
+  h->n_files = n;
+  h->handle = handle;
+  uvm_log_sink_n_handles++;
+  UVM_LOG_SINK_UNLOCK();
+  return 1;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_put
+//
+// Appends ~n~ bytes to the buffer of ~f~.  Called with the lock held.
+//--------------------------------------------------------------------
+static void uvm_log_sink_put(uvm_log_sink_file *f, const char *p, size_t n)
+{
+  while(f->len + n > UVM_LOG_SINK_BUF_SIZE) {
+    size_t room = UVM_LOG_SINK_BUF_SIZE - f->len;
+    memcpy(f->buf + f->len, p, room);
+    f->len += room;
+    p += room;
+    n -= room;
+#ifndef UVM_LOG_SINK_NO_THREADS
+    if(uvm_log_sink_running) {
+      uvm_log_sink_swap(f);
+      continue;
+    }
+#endif
+    fwrite(f->buf, 1, f->len, f->fp);
+    f->len = 0;
+  }
+  memcpy(f->buf + f->len, p, n);
+  f->len += n;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_write
+//
+// Writes ~str~ and a newline to the files of an attached ~handle~.
+//--------------------------------------------------------------------
+void uvm_log_sink_write(int handle, const char *str)
+{
+  size_t len = strlen(str);
+  int i;
+
+  UVM_LOG_SINK_LOCK();
+  if(uvm_log_sink_last < 0 || uvm_log_sink_handles[uvm_log_sink_last].handle != handle) {
+    for(i = 0; i < uvm_log_sink_n_handles; i++)
+      if(uvm_log_sink_handles[i].handle == handle)
+        break;
+    if(i == uvm_log_sink_n_handles) {
+      UVM_LOG_SINK_UNLOCK();
+      uvm_log_sink_error(M_UVM_ERROR, "write to a report file which is not attached to the log sink");
+      return;
+    }
+    uvm_log_sink_last = i;
+  }
+
+  for(i = 0; i < uvm_log_sink_handles[uvm_log_sink_last].n_files; i++) {
+    uvm_log_sink_file *f = uvm_log_sink_handles[uvm_log_sink_last].files[i];
+    uvm_log_sink_put(f, str, len);
+    uvm_log_sink_put(f, "\n", 1);
+  }
+  UVM_LOG_SINK_UNLOCK();
+}
+
+
+//--------------------------------------------------------------------
+// uvm_log_sink_flush
+//
+// Writes out all buffered messages, closes the files and forgets the
+// attached handles; handles are attached again on their next use.
+//--------------------------------------------------------------------
+void uvm_log_sink_flush(void)
+{
+  UVM_LOG_SINK_LOCK();
+  uvm_log_sink_detach_all();
+  UVM_LOG_SINK_UNLOCK();
+}
@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+
+
+//
+// Binary message log written by <uvm_default_report_server> when
+// enable_message_log is called or +UVM_MESSAGE_LOG is given.  The
+// record layout is described in uvm_msg_log.h; bin/uvm_msg_log.c
+// indexes and filters a log, and prints it in the usual text format.
+//
+// A log is written through the buffered writer and string table of
+// uvm_bin_tr.c, which uvm_dpi.cc includes first, and shares its
+// handles.
+//
+
+#include "uvm_dpi.h"
+#include "uvm_msg_log.h"
+
+
+//--------------------------------------------------------------------
+// uvm_msg_log_open
+//
+// Opens ~filename~ for appending and starts a new session in it.
+// Returns a log handle, or -1 on failure.
+//--------------------------------------------------------------------
+int uvm_msg_log_open(const char *filename, double time_scale)
+{
+  int log = uvm_bin_tr_open_file(filename, "message log");
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(log);
+
+  if(d == NULL)
+    return -1;
+  uvm_bin_tr_put(d, UVM_MSG_LOG_MAGIC, UVM_MSG_LOG_MAGIC_LEN);
+  uvm_bin_tr_put_f64(d, time_scale);
+  return log;
+}
+
+
+//--------------------------------------------------------------------
+// uvm_msg_log_flush
+//--------------------------------------------------------------------
+void uvm_msg_log_flush(int log)
+{
+  uvm_bin_tr_flush(log);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_msg_log_close
+//--------------------------------------------------------------------
+void uvm_msg_log_close(int log)
+{
+  uvm_bin_tr_close(log);
+}
+
+
+//--------------------------------------------------------------------
+// uvm_msg_log_write
+//
+// Writes a MESSAGE record.
+//--------------------------------------------------------------------
+void uvm_msg_log_write(int log, double t, int severity, int flags,
+                       int verbosity, const char *id, const char *name,
+                       const char *context, const char *filename,
+                       int line, const char *text)
+{
+  uvm_bin_tr_db *d = uvm_bin_tr_get_db(log);
+  unsigned i, n, c, f;
+  size_t len = text ? strlen(text) : 0;
+
+  if(d == NULL)
+    return;
+  i = uvm_bin_tr_intern(d, id);
+  n = uvm_bin_tr_intern(d, name);
+  c = uvm_bin_tr_intern(d, context);
+  f = uvm_bin_tr_intern(d, filename);
+  uvm_bin_tr_put_u8(d, UVM_MSG_LOG_MESSAGE);
+  uvm_bin_tr_put_f64(d, t);
+  uvm_bin_tr_put_u8(d, severity);
+  uvm_bin_tr_put_u8(d, flags);
+  uvm_bin_tr_put_u32(d, (unsigned) verbosity);
+  uvm_bin_tr_put_u32(d, i);
+  uvm_bin_tr_put_u32(d, n);
+  uvm_bin_tr_put_u32(d, c);
+  uvm_bin_tr_put_u32(d, f);
+  uvm_bin_tr_put_u32(d, (unsigned) line);
+  uvm_bin_tr_put_u32(d, (unsigned) len);
+  uvm_bin_tr_put(d, text, len);
+}
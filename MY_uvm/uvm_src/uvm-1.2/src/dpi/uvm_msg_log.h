@@ -0,0 +1,82 @@
+//----------------------------------------------------------------------
+//   All Rights Reserved Worldwide
+//
+//   Licensed under the Apache License, Version 2.0 (the
+//   "License"); you may not use this file except in
+//   compliance with the License.  You may obtain a copy of
+//   the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in
+//   writing, software distributed under the License is
+//   distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+//   CONDITIONS OF ANY KIND, either express or implied.  See
+//   the License for the specific language governing
+//   permissions and limitations under the License.
+//----------------------------------------------------------------------
+
+
+
+//
+// Record layout of the binary message log written by uvm_msg_log.c
+// for <uvm_default_report_server::enable_message_log>, and of the index
+// that bin/uvm_msg_log.c builds over it.  This header does not depend
+// on the simulator, so the reader can be built on its own.
+//
+// A log is a sequence of sessions, one per open of the log.  Each
+// session starts with the magic string and a f64 time scale (the value
+// of %0t for a time of 1).  Records follow, each starting with a u8
+// tag.  All numbers are little endian; f64 is an IEEE double.
+//
+//  STRING    u32 id, u32 len, len bytes
+//  MESSAGE   f64 time, u8 severity, u8 flags, i32 verbosity, u32 id,
+//            u32 name, u32 context, u32 file, i32 line, u32 len,
+//            len bytes of message text
+//
+// ~name~ is the full name of the report handler and ~context~ the
+// context of the message, as composed into "name@@context".  The text
+// includes any message elements, as they are displayed.  Ids, names,
+// contexts and files are interned as in uvm_bin_tr.h: the STRING
+// record that defines an id comes before its first use, and ids
+// restart with each session.
+//
+// The index file starts with the index magic, the u64 size of the log
+// when it was indexed and the u32 number of sessions.  Each session is
+// its u64 offset, f64 time scale, u32 number of strings and the
+// strings, u32 len and len bytes each, in id order.  Then comes the u32
+// number of blocks, each of which covers the MESSAGE and STRING records
+// of part of one session:
+//
+//  BLOCK     u64 offset, u64 end, u32 session, f64 min time,
+//            f64 max time, u8 severity mask, UVM_MSG_LOG_BLOOM_BYTES
+//            bytes of bloom filter over the message ids
+//
+
+#ifndef UVM_MSG_LOG__H
+#define UVM_MSG_LOG__H
+
+#define UVM_MSG_LOG_MAGIC        "UVMMSG1"
+#define UVM_MSG_LOG_MAGIC_LEN    8
+
+#define UVM_MSG_LOG_INDEX_MAGIC      "UVMMSGI1"
+#define UVM_MSG_LOG_INDEX_MAGIC_LEN  8
+
+// Same tag as UVM_BIN_TR_STRING, the string table is shared
+#define UVM_MSG_LOG_STRING       1
+#define UVM_MSG_LOG_MESSAGE      2
+
+// MESSAGE flags, the report server's settings when it was written
+#define UVM_MSG_LOG_SHOW_VERBOSITY   1
+#define UVM_MSG_LOG_SHOW_TERMINATOR  2
+
+// Bytes of message records covered by one index block
+#define UVM_MSG_LOG_BLOCK_SIZE   (1 << 20)
+
+#define UVM_MSG_LOG_BLOOM_BYTES  64
+
+// Bit positions of an id in a block's bloom filter
+#define UVM_MSG_LOG_BLOOM_1(id)  ((id) % (8*UVM_MSG_LOG_BLOOM_BYTES))
+#define UVM_MSG_LOG_BLOOM_2(id)  ((((id) * 2654435761u) >> 16) % (8*UVM_MSG_LOG_BLOOM_BYTES))
+
+#endif